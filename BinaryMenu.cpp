@@ -0,0 +1,296 @@
+/***************************************************************************//**
+ * BinaryMenu.cpp
+ *
+ * Author - Dan Andrus
+ *
+ * Date - October 18, 2026
+ *
+ * Details - Defines the black and white processes. The work is done in
+ * binaryimage.cpp.
+ *
+ ******************************************************************************/
+
+#include "BinaryMenu.h"
+#include <QMessageBox>
+
+/***************************************************************************//**
+ * BinaryMenu
+ * Author - Dan Andrus
+ *
+ * Starts with the threshold halfway up the intensity range and diagonal
+ * pixels connected.
+ ******************************************************************************/
+BinaryMenu::BinaryMenu() : threshold(128), eight(1)
+{
+}
+
+/***************************************************************************//**
+ * BinaryMenu::load
+ * Author - Dan Andrus
+ *
+ * Thresholds the image into a binary image. An image that is already black
+ * and white comes through unchanged at any threshold above 0.
+ *
+ * Parameters -
+ *          image - the image to threshold
+ *          binary - receives the black and white image
+ *
+ * Returns
+ *          true if successful, false if not
+ ******************************************************************************/
+bool BinaryMenu::load(Image& image, BinaryImage& binary)
+{
+  return !image.IsNull() && binary.fromImage(image, threshold);
+}
+
+/***************************************************************************//**
+ * Menu_Binary_Erode
+ * Author - Dan Andrus
+ *
+ * Erodes the white areas by a rectangle: a pixel stays white only if all the
+ * pixels under the rectangle are white.
+ *
+ * Parameters -
+            image - the image object to manipulate.
+ *
+ * Returns
+ *          true if successful, false if not
+ ******************************************************************************/
+bool BinaryMenu::Menu_Binary_Erode(Image& image)
+{
+  BinaryImage binary;
+  int width = 3, height = 3;
+
+  if (!Dialog("Binary Erode")
+        .Add(threshold, "Threshold", 1, 255)
+        .Add(width, "Width", 1, 999)
+        .Add(height, "Height", 1, 999).Show())
+    return false;
+  if (!load(image, binary)) return false;
+
+  binary.erode(width, height);
+  binary.toImage(image);
+  return true;
+}
+
+/***************************************************************************//**
+ * Menu_Binary_Dilate
+ * Author - Dan Andrus
+ *
+ * Dilates the white areas by a rectangle: a pixel becomes white if any pixel
+ * under the rectangle is white.
+ *
+ * Parameters -
+            image - the image object to manipulate.
+ *
+ * Returns
+ *          true if successful, false if not
+ ******************************************************************************/
+bool BinaryMenu::Menu_Binary_Dilate(Image& image)
+{
+  BinaryImage binary;
+  int width = 3, height = 3;
+
+  if (!Dialog("Binary Dilate")
+        .Add(threshold, "Threshold", 1, 255)
+        .Add(width, "Width", 1, 999)
+        .Add(height, "Height", 1, 999).Show())
+    return false;
+  if (!load(image, binary)) return false;
+
+  binary.dilate(width, height);
+  binary.toImage(image);
+  return true;
+}
+
+/***************************************************************************//**
+ * Menu_Binary_Majority
+ * Author - Dan Andrus
+ *
+ * The binary median filter: a pixel becomes white if more than half the
+ * pixels in the square around it are white.
+ *
+ * Parameters -
+            image - the image object to manipulate.
+ *
+ * Returns
+ *          true if successful, false if not
+ ******************************************************************************/
+bool BinaryMenu::Menu_Binary_Majority(Image& image)
+{
+  BinaryImage binary;
+  int size = 3;
+
+  if (!Dialog("Binary Majority")
+        .Add(threshold, "Threshold", 1, 255)
+        .Add(size, "Size", 3, 99).Show())
+    return false;
+  if (!load(image, binary)) return false;
+
+  binary.majority(size);
+  binary.toImage(image);
+  return true;
+}
+
+/***************************************************************************//**
+ * Menu_Binary_CountPixels
+ * Author - Dan Andrus
+ *
+ * Shows how many pixels are white at the threshold. The image is not changed.
+ *
+ * Parameters -
+            image - the image object to inspect.
+ *
+ * Returns
+ *          false, since the image is not changed
+ ******************************************************************************/
+bool BinaryMenu::Menu_Binary_CountPixels(Image& image)
+{
+  BinaryImage binary;
+  qulonglong white;
+  qulonglong total;
+
+  if (!getParams(threshold)) return false;
+  if (!load(image, binary)) return false;
+
+  white = binary.count();
+  total = (qulonglong) binary.width() * binary.height();
+  QMessageBox::information(0, "Count Pixels",
+    QString("White pixels: %1 of %2 (%3%)")
+      .arg(white).arg(total).arg(100.0 * white / total, 0, 'f', 2));
+  return false;
+}
+
+/***************************************************************************//**
+ * Menu_Binary_LabelComponents
+ * Author - Dan Andrus
+ *
+ * Finds the connected white areas and paints each one its own color on a
+ * black background.
+ *
+ * Parameters -
+            image - the image object to manipulate.
+ *
+ * Returns
+ *          true if successful, false if not
+ ******************************************************************************/
+bool BinaryMenu::Menu_Binary_LabelComponents(Image& image)
+{
+  BinaryImage binary;
+  ImagePlanes planes;
+  vector<int> labels;
+  vector<Blob> blobs;
+  int n;
+
+  if (!Dialog("Label Components")
+        .Add(threshold, "Threshold", 1, 255)
+        .Add(eight, "Connect Diagonals (0 or 1)", 0, 1).Show())
+    return false;
+  if (!load(image, binary)) return false;
+
+  labelComponents(binary, eight ? Connect8 : Connect4, labels, blobs);
+
+  // Spread the label numbers over the colors with a multiplicative hash
+  n = (int) labels.size();
+  planes.width = binary.width();
+  planes.height = binary.height();
+  planes.red.resize(n);
+  planes.green.resize(n);
+  planes.blue.resize(n);
+  #pragma omp parallel for
+  for (int k = 0; k < n; k++)
+  {
+    unsigned int color = labels[k] ? labels[k] * 2654435761u | 0x404040 : 0;
+    planes.red[k] = color >> 16;
+    planes.green[k] = color >> 8;
+    planes.blue[k] = color;
+  }
+
+  packRegions(planes, 0, 0, imageRegions(planes.width, planes.height), image);
+  return true;
+}
+
+/***************************************************************************//**
+ * Menu_Binary_BlobStatistics
+ * Author - Dan Andrus
+ *
+ * Shows how many connected white areas there are, their sizes, and the
+ * bounding box and centroid of the largest. The image is not changed.
+ *
+ * Parameters -
+            image - the image object to inspect.
+ *
+ * Returns
+ *          false, since the image is not changed
+ ******************************************************************************/
+bool BinaryMenu::Menu_Binary_BlobStatistics(Image& image)
+{
+  BinaryImage binary;
+  vector<int> labels;
+  vector<Blob> blobs;
+  qulonglong total = 0;
+  size_t largest = 0, smallest = 0, k;
+  QString text("No white pixels");
+
+  if (!Dialog("Blob Statistics")
+        .Add(threshold, "Threshold", 1, 255)
+        .Add(eight, "Connect Diagonals (0 or 1)", 0, 1).Show())
+    return false;
+  if (!load(image, binary)) return false;
+
+  labelComponents(binary, eight ? Connect8 : Connect4, labels, blobs);
+
+  for (k = 0; k < blobs.size(); k++)
+  {
+    total += blobs[k].area;
+    if (blobs[k].area > blobs[largest].area) largest = k;
+    if (blobs[k].area < blobs[smallest].area) smallest = k;
+  }
+
+  if (!blobs.empty())
+  {
+    const Blob& big = blobs[largest];
+    text = QString("%1 blobs, areas %2 to %3 (mean %4)\n"
+                   "Largest: %5 pixels at %6,%7 size %8x%9, centroid (%10, %11)")
+             .arg((qulonglong) blobs.size())
+             .arg((qulonglong) blobs[smallest].area)
+             .arg((qulonglong) big.area)
+             .arg((double) total / blobs.size(), 0, 'f', 1)
+             .arg((qulonglong) big.area)
+             .arg(big.box.x).arg(big.box.y).arg(big.box.w).arg(big.box.h)
+             .arg(big.cx, 0, 'f', 1).arg(big.cy, 0, 'f', 1);
+  }
+
+  QMessageBox::information(0, "Blob Statistics", text);
+  return false;
+}
+
+/***************************************************************************//**
+ * Menu_Binary_DistanceTransform
+ * Author - Derek Stotz
+ *
+ * Replaces every pixel with its distance to the nearest white pixel, as a
+ * gray level. The distance can be exact, exact and squared, or the faster
+ * chamfer approximation, and is multiplied by a scale before display.
+ *
+ * Parameters -
+            image - the image object to manipulate.
+ *
+ * Returns
+ *          true if successful, false if not
+ ******************************************************************************/
+bool BinaryMenu::Menu_Binary_DistanceTransform(Image& image)
+{
+  int metric = EuclideanDistance;
+  double scale = 1.0;
+
+  if (image.IsNull()) return false;
+
+  if (!Dialog("Distance Transform")
+        .Add(threshold, "Threshold", 1, 255)
+        .Add(metric, "Distance (0 Euclidean, 1 Squared, 2 Chamfer)", 0, 2)
+        .Add(scale, "Gray Levels per Pixel", 0.01, 255.0).Show())
+    return false;
+
+  return distanceImage(image, threshold, (distanceMetric) metric, scale);
+}
@@ -0,0 +1,47 @@
+/***************************************************************************//**
+ * BinaryMenu.h
+ *
+ * Author - Dan Andrus
+ *
+ * Date - October 18, 2026
+ *
+ * Details - Contains the declaration for the BinaryMenu class
+ *
+ ******************************************************************************/
+
+#include "components.h"
+#include "distance.h"
+
+/***************************************************************************//**
+ * BinaryMenu
+ *
+ * Author - Dan Andrus
+ *
+ * Child of QObject class.
+ *
+ * Declares the black and white processes. Each thresholds the image into a
+ * bit-packed BinaryImage, works on it 64 pixels at a time and writes the
+ * result back as black and white.
+ ******************************************************************************/
+class BinaryMenu : public QObject
+{
+  Q_OBJECT
+
+  private:
+    int threshold;                      // Lowest intensity taken as white
+    int eight;                          // 1 if diagonal pixels connect
+
+    bool load(Image& image, BinaryImage& binary);
+
+  public:
+    BinaryMenu();
+
+  public slots:
+    bool Menu_Binary_Erode(Image& image);
+    bool Menu_Binary_Dilate(Image& image);
+    bool Menu_Binary_Majority(Image& image);
+    bool Menu_Binary_CountPixels(Image& image);
+    bool Menu_Binary_LabelComponents(Image& image);
+    bool Menu_Binary_BlobStatistics(Image& image);
+    bool Menu_Binary_DistanceTransform(Image& image);
+};
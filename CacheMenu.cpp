@@ -0,0 +1,86 @@
+/***************************************************************************//**
+ * CacheMenu.cpp
+ *
+ * Author - Dan Andrus
+ *
+ * Date - October 18, 2026
+ *
+ * Details - Defines the result cache processes.
+ *
+ ******************************************************************************/
+
+#include "CacheMenu.h"
+#include <QMessageBox>
+
+/***************************************************************************//**
+ * Menu_Cache_Statistics
+ * Author - Dan Andrus
+ *
+ * Shows how often the cache has saved a filter run and how much it holds.
+ *
+ * Parameters -
+            image - the image object (unused).
+ *
+ * Returns
+ *          false, since the image is not changed
+ ******************************************************************************/
+bool CacheMenu::Menu_Cache_Statistics(Image& image)
+{
+  Q_UNUSED(image);
+
+  ResultCache& cache = resultCache();
+  QString text = QString("%1 hits, %2 misses\n%3 results using %4 of %5 KB")
+                   .arg(cache.hits())
+                   .arg(cache.misses())
+                   .arg(cache.entries())
+                   .arg((qulonglong) (cache.bytesUsed() / 1024))
+                   .arg((qulonglong) (cache.budget() / 1024));
+
+  QMessageBox::information(0, "Result Cache", text);
+  return false;
+}
+
+/***************************************************************************//**
+ * Menu_Cache_SetBudget
+ * Author - Dan Andrus
+ *
+ * Asks how much memory the cache may use. The oldest results are dropped if
+ * the cache no longer fits.
+ *
+ * Parameters -
+            image - the image object (unused).
+ *
+ * Returns
+ *          false, since the image is not changed
+ ******************************************************************************/
+bool CacheMenu::Menu_Cache_SetBudget(Image& image)
+{
+  Q_UNUSED(image);
+
+  int megabytes = (int)(resultCache().budget() >> 20);
+
+  if (Dialog("Result Cache").Add(megabytes, "Budget (MB)", 0, 4096).Show())
+    resultCache().setBudget((size_t)megabytes << 20);
+
+  return false;
+}
+
+/***************************************************************************//**
+ * Menu_Cache_Clear
+ * Author - Dan Andrus
+ *
+ * Drops every cached result and resets the statistics.
+ *
+ * Parameters -
+            image - the image object (unused).
+ *
+ * Returns
+ *          false, since the image is not changed
+ ******************************************************************************/
+bool CacheMenu::Menu_Cache_Clear(Image& image)
+{
+  Q_UNUSED(image);
+
+  resultCache().clear();
+  return false;
+}
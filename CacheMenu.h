@@ -0,0 +1,32 @@
+/***************************************************************************//**
+ * CacheMenu.h
+ *
+ * Author - Dan Andrus
+ *
+ * Date - October 18, 2026
+ *
+ * Details - Contains the declaration for the CacheMenu class
+ *
+ ******************************************************************************/
+
+#include "resultcache.h"
+
+/***************************************************************************//**
+ * CacheMenu
+ *
+ * Author - Dan Andrus
+ *
+ * Child of QObject class.
+ *
+ * Declares processes that report on and size the cache of filter outputs.
+ * None of them change the image.
+ ******************************************************************************/
+class CacheMenu : public QObject
+{
+  Q_OBJECT
+
+  public slots:
+    bool Menu_Cache_Statistics(Image& image);
+    bool Menu_Cache_SetBudget(Image& image);
+    bool Menu_Cache_Clear(Image& image);
+};
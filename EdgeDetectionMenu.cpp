@@ -11,6 +11,10 @@
  ******************************************************************************/
 
 #include "EdgeDetectionMenu.h"
+#include "asyncfilter.h"
+#include "resultcache.h"
+#include "canny.h"
+#include "neighborhood.h"
 
 /***************************************************************************//**
  * Menu_EdgeDetection_3x3SharpeningFilter
@@ -269,106 +273,107 @@ bool EdgeDetectionMenu::Menu_EdgeDetection_RangeFilter(Image& image)
 }
 
 /***************************************************************************//**
- * sobel
- * Author - Dan Andrus
+ * Menu_EdgeDetection_Canny
+ * Author - Derek Stotz
  *
- * Applies the Kirsch edge operator to an image, either highlighting edges or
- * illustrating edge directions based on the mag parameter.
+ * Finds thin, connected edges with the Canny edge detector: Gaussian
+ * smoothing, the Sobel gradient, non-maximum suppression and hysteresis
+ * between two thresholds. Edges are drawn white on black.
  *
- * Parameters - 
- *          image - the image object to manipulate.
- *          mag - if true, highlights edges. If false, illustrates edge angles
+ * Parameters -
+            image - the image object to manipulate.
  *
  * Returns
- *          True if the operation was successful, false if not
+ *          true if successful, false if not
  ******************************************************************************/
-bool EdgeDetectionMenu::sobel(Image& image, bool mag)
+bool EdgeDetectionMenu::Menu_EdgeDetection_Canny(Image& image)
 {
-  // Make sure image isn't null
   if (image.IsNull()) return false;
-  
-  // Initialize variables
-  Image copy;                           // Copy of original image
-  int img_w;                            // Overal image width
-  int img_h;                            // Overal image height
-  int sum[2];                           // Sum of intensities
-  int center_x;                         // Center of mask
-  int center_y;                         // Center of mask
-  int i, j, k, l, x, y;                 // Temporary variables
-  int mask1[3][3] = {
-    {-1, 0, +1},
-    {-2, 0, +2},
-    {-1, 0, +1}
-  };
-  int mask2[3][3] = {
-    {-1, -2, -1},
-    {0, 0, 0},
-    {+1, +2, +1}
-  };
-  int mask_w = 3;
-  int mask_h = 3;
-  
-  // Copy image due to nature of algorithm
-  copy = image;
-  
-  // Get image dimensions
-  img_w = image.Width();
-  img_h = image.Height();
-  
-  // Find center of mask
-  center_x = 1;
-  center_y = 1;
-  
-  // Begin applying mask to image
-  for (i = 0; i < img_h; ++i)           // Loop over rows
+
+  double sigma = 1.4;
+  int low = 40;
+  int high = 100;
+
+  if (!Dialog("Canny Edge Detection")
+        .Add(sigma, "Sigma (0 for no smoothing)", 0.0, 100.0)
+        .Add(low, "Low Threshold", 0, 1500)
+        .Add(high, "High Threshold", 0, 1500).Show())
+    return false;
+
+  return cannyImage(image, sigma, low, high);
+}
+
+/***************************************************************************//**
+ * SobelReducer
+ * Author - Dan Andrus
+ *
+ * Reducer for the Sobel operator: the magnitude or direction of the gradient.
+ * Works a whole row at a time, so the gradient loop runs over plain arrays.
+ ******************************************************************************/
+struct SobelReducer
+{
+  static const planeInput input = IntensityInput;
+
+  MaskShape shape;                      // Reach of the masks
+  bool mag;                             // Magnitude or direction
+  vector<int> gx;                       // Horizontal gradient of a row
+  vector<int> gy;                       // Vertical gradient of a row
+
+  SobelReducer(bool m) : shape(3, 3), mag(m) {}
+
+  void reduceRow(const uchar* const* rows, int n, uchar* out)
   {
-    for (j = 0; j < img_w; ++j)         // Loop over columns
+    int sum;                            // Output value
+
+    // The same gradient the Canny detector uses (see canny.h). The rows are
+    // padded, so column j of the output is column j + 1 of the rows
+    gx.resize(n + 2);
+    gy.resize(n + 2);
+    sobelRow(rows[0], rows[1], rows[2], n + 2, 1, n + 1, &gx[0], &gy[0]);
+
+    for (int j = 1; j <= n; ++j)
     {
-      // Reset variables
-      sum[0] = 0;
-      sum[1] = 0;
-      
-      // Center mask over pixel and take weighted average
-      for (k = 0; k < mask_h; ++k)      // Loop over mask rows
-      {
-        for (l = 0; l < mask_w; ++l)    // Loop over mask columns
-        {
-          // Temporarily store variable of current pixel to sum
-          x = j + (l - center_x);
-          y = i + (k - center_y);
-          
-          // If a pixel would be out of bounds, use nearest valid pixel
-          if (x < 0)      x = 0;
-          if (x >= img_w) x = img_w - 1;
-          if (y < 0)      y = 0;
-          if (y >= img_h) y = img_h - 1;
-          
-          // Add intensity values to sum with weights
-          sum[0] += copy[y][x] * mask1[k][l];
-          sum[1] += copy[y][x] * mask2[k][l];
-        }
-      }
-      
-      // Now we use sum[0] for our value
-      
       // Calculate direction or magnitude
       if (mag)
-        sum[0] = sqrt((double) (sum[0] * sum[0]) + (double) (sum[1] * sum[1]));
+        sum = sqrt((double) (gx[j] * gx[j]) + (double) (gy[j] * gy[j]));
       else {
-        sum[0] = (int) (((atan2((double) -sum[1], (double) sum[0]) * 255) / M_PI) / 2);
-        if (sum[0] < 0) sum[0] += 255;
+        sum = (int) (((atan2((double) -gy[j], (double) gx[j]) * 255) / M_PI) / 2);
+        if (sum < 0) sum += 255;
       }
-      
+
       // Clip values should they be invalid
-      if (sum[0] < 0)     sum[0] = 0;
-      if (sum[0] >= 256)  sum[0] = 256-1; // Why not 255? to match lines 69-72
-      
-      // Put new RGB values into image
-      image[i][j].SetGray(sum[0]);
+      if (sum < 0)     sum = 0;
+      if (sum >= 256)  sum = 256-1; // Why not 255? to match lines 69-72
+
+      out[j - 1] = sum;
     }
   }
+};
+
+/***************************************************************************//**
+ * sobel
+ * Author - Dan Andrus
+ *
+ * Applies the Kirsch edge operator to an image, either highlighting edges or
+ * illustrating edge directions based on the mag parameter. Outputs are kept in
+ * the result cache, so running it again on the same image is instant.
+ *
+ * Parameters - 
+ *          image - the image object to manipulate.
+ *          mag - if true, highlights edges. If false, illustrates edge angles
+ *
+ * Returns
+ *          True if the operation was successful, false if not
+ ******************************************************************************/
+bool EdgeDetectionMenu::sobel(Image& image, bool mag)
+{
+  // Make sure image isn't null
+  if (image.IsNull()) return false;
   
-  return true;
+  // Only the active regions are filtered, and an earlier run on the same
+  // pixels is reused
+  return neighborhoodImage(image, SobelReducer(mag), 0,
+                           mag ? "sobel magnitude" : "sobel direction");
 }
 
 /***************************************************************************//**
@@ -376,7 +381,8 @@ bool EdgeDetectionMenu::sobel(Image& image, bool mag)
  * Author - Dan Andrus
  *
  * Applies the Kirsch edge operator to an image, illustrating edge directions or
- * highlighting edge magintudes based on the value of mag
+ * highlighting edge magintudes based on the value of mag. Runs behind a
+ * progress dialog that can cancel it.
  *
  * Parameters - 
  *          image - the image object to manipulate.
@@ -391,118 +397,14 @@ bool EdgeDetectionMenu::kirsch(Image &image, bool mag)
   if (image.IsNull()) return false;
   
   // Initialize variables
-  Image copy;                           // Copy of original image
-  int img_w;                            // Overal image width
-  int img_h;                            // Overal image height
-  int dir;                              // Direction of max response
-  int sum[8];                           // Sum of responsivenesses
-  int max;                              // Magnitude of max response
-  int center_x;                         // Center of mask
-  int center_y;                         // Center of mask
-  int i, j, k, l, m, x, y;              // Temporary variables
-  int mask[8][3][3] = {{
-    {-3, -3,  5},
-    {-3,  0,  5},
-    {-3, -3,  5}
-  }, {
-    {-3,  5,  5},
-    {-3,  0,  5},
-    {-3, -3, -3}
-  }, {
-    { 5,  5,  5},
-    {-3,  0, -3},
-    {-3, -3, -3}
-  }, {
-    { 5,  5, -3},
-    { 5,  0, -3},
-    {-3, -3, -3}
-  }, {
-    { 5, -3, -3},
-    { 5,  0, -3},
-    { 5, -3, -3}
-  }, {
-    {-3, -3, -3},
-    { 5,  0, -3},
-    { 5,  5, -3}
-  }, {
-    {-3, -3, -3},
-    {-3,  0, -3},
-    { 5,  5,  5}
-  }, {
-    {-3, -3, -3},
-    {-3,  0,  5},
-    {-3,  5,  5}
-  }};
-  int mask_w = 3;
-  int mask_h = 3;
-  
-  // Copy image due to nature of algorithm
-  copy = image;
+  FilterTask task;                      // What to run in the background
   
-  // Get image dimensions
-  img_w = image.Width();
-  img_h = image.Height();
+  task.kind = KirschFilter;
+  task.op = Max;
+  task.mask_w = 3;
+  task.threshold = 0;
+  task.mag = mag;
   
-  // Find center of mask
-  center_x = 1;
-  center_y = 1;
-  
-  // Begin applying mask to image
-  for (i = 0; i < img_h; ++i)           // Loop over rows
-  {
-    for (j = 0; j < img_w; ++j)         // Loop over columns
-    {
-      // Reset variables
-      dir = -1;
-      max = -1;
-      for (m = 0; m < 8; ++m)
-        sum[m] = 0;
-      
-      // Center each mask over pixel and take weighted average
-      for (k = 0; k < mask_h; ++k)      // Loop over mask rows
-      {
-        for (l = 0; l < mask_w; ++l)    // Loop over mask columns
-        {
-          for (m = 0; m < 8; ++m)       // Loop over all masks
-          {
-            // Temporarily store variable of current pixel we're going to sum
-            x = j + (l - center_x);
-            y = i + (k - center_y);
-          
-            // If a pixel would be out of bounds, use nearest valid pixel
-            if (x < 0)      x = 0;
-            if (x >= img_w) x = img_w - 1;
-            if (y < 0)      y = 0;
-            if (y >= img_h) y = img_h - 1;
-          
-            // Add intensity values to sum with weights
-            sum[m] += copy[y][x].Intensity() * mask[m][k][l];
-          }
-        }
-      }
-      
-      // Find mask with max response
-      for (m = 0; m < 8; ++m)
-      {
-        if (sum[m] > max)
-        {
-          max = sum[m];
-          dir = m;
-        }
-      }
-      
-      // Put new intensity into image
-      if (mag)
-      {
-        image[i][j].SetGray(std::max(0, min(255, max)));
-      }
-      else
-      {
-        image[i][j] = (dir * (256/8));
-      }
-    }
-  }
-  
-  return true;
+  // Apply the masks in the background (see kirschBand)
+  return runWithProgress(image, task, "Kirsch Edge Detection");
 }
-
@@ -39,5 +39,6 @@ class EdgeDetectionMenu : public QObject
     bool Menu_EdgeDetection_KirschDirection(Image& image);
     bool Menu_EdgeDetection_StandardDeviation(Image& image);
     bool Menu_EdgeDetection_RangeFilter(Image& image);
+    bool Menu_EdgeDetection_Canny(Image& image);
 };
 
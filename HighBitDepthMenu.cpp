@@ -0,0 +1,252 @@
+/***************************************************************************//**
+ * HighBitDepthMenu.cpp
+ *
+ * Author - Derek Stotz
+ *
+ * Date - October 18, 2026
+ *
+ * Details - Defines the 16-bit processes. The work is done in deepimage.cpp
+ * and by the templated neighborhood filters.
+ *
+ ******************************************************************************/
+
+#include "HighBitDepthMenu.h"
+#include "resultcache.h"
+#include <QFileDialog>
+#include <QMessageBox>
+
+/***************************************************************************//**
+ * imageHash
+ * Author - Derek Stotz
+ *
+ * Hashes the pixels of an image, to tell whether it still shows the 16-bit
+ * copy.
+ ******************************************************************************/
+static unsigned long long imageHash(Image& image)
+{
+  ImagePlanes planes;
+
+  if (!unpackImage(image, planes)) return 0;
+  return hashPlanes(planes);
+}
+
+/***************************************************************************//**
+ * HighBitDepthMenu
+ * Author - Derek Stotz
+ *
+ * Starts with no 16-bit copy; the first process takes it from the image.
+ ******************************************************************************/
+HighBitDepthMenu::HighBitDepthMenu() : shown(0)
+{
+}
+
+/***************************************************************************//**
+ * HighBitDepthMenu::ready
+ * Author - Derek Stotz
+ *
+ * Makes sure the 16-bit copy belongs to the image. If the image no longer
+ * shows the copy (another image was opened, or another process changed it)
+ * the copy is replaced by the image's intensities.
+ *
+ * Parameters -
+ *          image - the image being worked on
+ *
+ * Returns
+ *          true if there is a copy to work on, false if the image is null
+ ******************************************************************************/
+bool HighBitDepthMenu::ready(Image& image)
+{
+  if (image.IsNull()) return false;
+
+  unsigned long long hash = imageHash(image);
+
+  if (deep.data.empty() || hash != shown)
+  {
+    if (!deepFromImage(image, deep)) return false;
+    shown = hash;
+  }
+
+  return true;
+}
+
+/***************************************************************************//**
+ * HighBitDepthMenu::show
+ * Author - Derek Stotz
+ *
+ * Shows the 16-bit copy in the image, scaled down to 8 bits.
+ *
+ * Parameters -
+ *          image - receives the scaled copy
+ *
+ * Returns
+ *          true if successful, false if not
+ ******************************************************************************/
+bool HighBitDepthMenu::show(Image& image)
+{
+  if (!deepToImage(deep, image)) return false;
+
+  shown = imageHash(image);
+  return true;
+}
+
+/***************************************************************************//**
+ * Menu_HighBitDepth_OpenPGM
+ * Author - Derek Stotz
+ *
+ * Reads a PGM file at its full depth, up to 16 bits, and shows it.
+ *
+ * Parameters -
+            image - the image object to manipulate.
+ *
+ * Returns
+ *          true if successful, false if not
+ ******************************************************************************/
+bool HighBitDepthMenu::Menu_HighBitDepth_OpenPGM(Image& image)
+{
+  QString path = QFileDialog::getOpenFileName(0, "Open PGM", "", "PGM images (*.pgm)");
+
+  if (path.isEmpty()) return false;
+
+  if (!readPgm(path.toStdString(), deep))
+  {
+    QMessageBox::information(0, "Open PGM", "Not a PGM file that can be read");
+    return false;
+  }
+
+  return show(image);
+}
+
+/***************************************************************************//**
+ * Menu_HighBitDepth_SavePGM
+ * Author - Derek Stotz
+ *
+ * Writes the 16-bit copy of the image to a PGM file, two bytes per pixel
+ * unless it only holds 8-bit values.
+ *
+ * Parameters -
+            image - the image object (unchanged).
+ *
+ * Returns
+ *          false, since the image is not changed
+ ******************************************************************************/
+bool HighBitDepthMenu::Menu_HighBitDepth_SavePGM(Image& image)
+{
+  if (!ready(image)) return false;
+
+  QString path = QFileDialog::getSaveFileName(0, "Save PGM", "", "PGM images (*.pgm)");
+
+  if (path.isEmpty()) return false;
+
+  if (!writePgm(path.toStdString(), deep))
+    QMessageBox::information(0, "Save PGM", "The file could not be written");
+
+  return false;
+}
+
+/***************************************************************************//**
+ * Menu_HighBitDepth_Mean
+ * Author - Derek Stotz
+ *
+ * Smooths the 16-bit copy with a square averaging filter, at full depth.
+ *
+ * Parameters -
+            image - the image object to manipulate.
+ *
+ * Returns
+ *          true if successful, false if not
+ ******************************************************************************/
+bool HighBitDepthMenu::Menu_HighBitDepth_Mean(Image& image)
+{
+  int mask_w = 3;                       // The width of the filter
+  int** mask;                           // Mask of ones
+  Plane16 result;                       // The smoothed copy
+  bool done;
+
+  if (!ready(image)) return false;
+
+  if (!Dialog("16-bit Mean").Add(mask_w, "Filter Width", 1, 99).Show())
+    return false;
+
+  mask = alloc2d(mask_w, mask_w);
+  for (int i = 0; i < mask_w; i++)
+    for (int j = 0; j < mask_w; j++)
+      mask[i][j] = 1;
+
+  done = filterDeep(deep, result, MaskAverage<unsigned short>(compileMask(mask, mask_w, mask_w)));
+  dealloc2d(mask, mask_w);
+
+  if (!done) return false;
+  deep.data.swap(result.data);
+  return show(image);
+}
+
+/***************************************************************************//**
+ * Menu_HighBitDepth_Median
+ * Author - Derek Stotz
+ *
+ * Median filters the 16-bit copy with a square window, at full depth.
+ *
+ * Parameters -
+            image - the image object to manipulate.
+ *
+ * Returns
+ *          true if successful, false if not
+ ******************************************************************************/
+bool HighBitDepthMenu::Menu_HighBitDepth_Median(Image& image)
+{
+  int mask_w = 3;                       // The width of the filter
+  Plane16 result;                       // The filtered copy
+
+  if (!ready(image)) return false;
+
+  if (!Dialog("16-bit Median").Add(mask_w, "Filter Width", 1, 99).Show())
+    return false;
+
+  if (!medianDeep(deep, result, mask_w)) return false;
+  deep.data.swap(result.data);
+  return show(image);
+}
+
+/***************************************************************************//**
+ * Menu_HighBitDepth_Gaussian
+ * Author - Derek Stotz
+ *
+ * Smooths the 16-bit copy with a Gaussian of any sigma, computed in floating
+ * point and rounded back to 16 bits once.
+ *
+ * Parameters -
+            image - the image object to manipulate.
+ *
+ * Returns
+ *          true if successful, false if not
+ ******************************************************************************/
+bool HighBitDepthMenu::Menu_HighBitDepth_Gaussian(Image& image)
+{
+  double sigma = 2.0;
+
+  if (!ready(image)) return false;
+
+  if (!Dialog("16-bit Gaussian Smoothing").Add(sigma, "Sigma", 0.5, 100.0).Show())
+    return false;
+
+  if (!gaussianDeep(deep, sigma)) return false;
+  return show(image);
+}
+
+/***************************************************************************//**
+ * Menu_HighBitDepth_Equalize
+ * Author - Derek Stotz
+ *
+ * Equalizes the histogram of the 16-bit copy over all of its levels.
+ *
+ * Parameters -
+            image - the image object to manipulate.
+ *
+ * Returns
+ *          true if successful, false if not
+ ******************************************************************************/
+bool HighBitDepthMenu::Menu_HighBitDepth_Equalize(Image& image)
+{
+  if (!ready(image) || !equalizeDeep(deep)) return false;
+  return show(image);
+}
@@ -0,0 +1,47 @@
+/***************************************************************************//**
+ * HighBitDepthMenu.h
+ *
+ * Author - Derek Stotz
+ *
+ * Date - October 18, 2026
+ *
+ * Details - Contains the declaration for the HighBitDepthMenu class
+ *
+ ******************************************************************************/
+
+#include "deepimage.h"
+
+/***************************************************************************//**
+ * HighBitDepthMenu
+ *
+ * Author - Derek Stotz
+ *
+ * Child of QObject class.
+ *
+ * Declares processes that work on a 16-bit greyscale copy of the image, read
+ * from or written to 16-bit PGM files. The copy is kept here at full depth
+ * and the image only shows it scaled down to 8 bits. If the image is changed
+ * some other way, its 8-bit intensities replace the copy.
+ ******************************************************************************/
+class HighBitDepthMenu : public QObject
+{
+  Q_OBJECT
+
+  public:
+    HighBitDepthMenu();
+
+  public slots:
+    bool Menu_HighBitDepth_OpenPGM(Image& image);
+    bool Menu_HighBitDepth_SavePGM(Image& image);
+    bool Menu_HighBitDepth_Mean(Image& image);
+    bool Menu_HighBitDepth_Median(Image& image);
+    bool Menu_HighBitDepth_Gaussian(Image& image);
+    bool Menu_HighBitDepth_Equalize(Image& image);
+
+  private:
+    bool ready(Image& image);
+    bool show(Image& image);
+
+    Plane16 deep;                       // The image at full depth
+    unsigned long long shown;           // Hash of the image deep was shown in
+};
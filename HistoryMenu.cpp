@@ -0,0 +1,113 @@
+/***************************************************************************//**
+ * HistoryMenu.cpp
+ *
+ * Author - Derek Stotz
+ *
+ * Date - October 18, 2026
+ *
+ * Details - Defines the snapshot history processes.
+ *
+ ******************************************************************************/
+
+#include "HistoryMenu.h"
+#include <QMessageBox>
+
+/***************************************************************************//**
+ * Menu_History_Checkpoint
+ * Author - Derek Stotz
+ *
+ * Saves the image as it is now. Only tiles that changed since the last
+ * checkpoint take up new memory.
+ *
+ * Parameters -
+            image - the image object to save.
+ *
+ * Returns
+ *          true if successful, false if not
+ ******************************************************************************/
+bool HistoryMenu::Menu_History_Checkpoint(Image& image)
+{
+  return histories[&image].checkpoint(image);
+}
+
+/***************************************************************************//**
+ * Menu_History_Undo
+ * Author - Derek Stotz
+ *
+ * Restores the image to its most recent checkpoint and drops it. Images
+ * without a checkpoint of their own are left alone.
+ *
+ * Parameters -
+            image - the image object to manipulate.
+ *
+ * Returns
+ *          true if successful, false if not
+ ******************************************************************************/
+bool HistoryMenu::Menu_History_Undo(Image& image)
+{
+  std::map<const Image*, SnapshotHistory>::iterator it = histories.find(&image);
+  bool restored;                        // Whether a snapshot was restored
+
+  if (it == histories.end()) return false;
+
+  restored = it->second.undo(image);
+  if (it->second.size() == 0) histories.erase(it);
+  return restored;
+}
+
+/***************************************************************************//**
+ * Menu_History_Reset
+ * Author - Derek Stotz
+ *
+ * Restores the image to its first checkpoint and clears its history.
+ *
+ * Parameters -
+            image - the image object to manipulate.
+ *
+ * Returns
+ *          true if successful, false if not
+ ******************************************************************************/
+bool HistoryMenu::Menu_History_Reset(Image& image)
+{
+  std::map<const Image*, SnapshotHistory>::iterator it = histories.find(&image);
+  bool restored;                        // Whether a snapshot was restored
+
+  if (it == histories.end()) return false;
+
+  restored = it->second.reset(image);
+  histories.erase(it);
+  return restored;
+}
+
+/***************************************************************************//**
+ * Menu_History_MemoryUsage
+ * Author - Derek Stotz
+ *
+ * Reports how many checkpoints are held for the image and how much memory
+ * they share.
+ *
+ * Parameters -
+            image - the image whose history is reported
+ *
+ * Returns
+ *          false, since the image is not changed
+ ******************************************************************************/
+bool HistoryMenu::Menu_History_MemoryUsage(Image& image)
+{
+  std::map<const Image*, SnapshotHistory>::iterator it = histories.find(&image);
+  int count = 0;                        // Checkpoints held for the image
+  size_t bytes = 0;                     // Tile memory they use
+
+  if (it != histories.end())
+  {
+    count = it->second.size();
+    bytes = it->second.bytesUsed();
+  }
+
+  QString text = QString("%1 checkpoints using %2 KB")
+                   .arg(count)
+                   .arg((qulonglong) (bytes / 1024));
+
+  QMessageBox::information(0, "History", text);
+  return false;
+}
@@ -0,0 +1,39 @@
+/***************************************************************************//**
+ * HistoryMenu.h
+ *
+ * Author - Derek Stotz
+ *
+ * Date - October 18, 2026
+ *
+ * Details - Contains the declaration for the HistoryMenu class
+ *
+ ******************************************************************************/
+
+#include "tiledimage.h"
+#include <map>
+
+/***************************************************************************//**
+ * HistoryMenu
+ *
+ * Author - Derek Stotz
+ *
+ * Child of QObject class.
+ *
+ * Declares checkpoint, undo and reset processes backed by a snapshot history
+ * whose snapshots share unchanged tiles, so a long chain of filter steps can
+ * be kept without a full copy of the image per step. Every open image keeps
+ * its own history, so undo in one window never restores another's pixels.
+ ******************************************************************************/
+class HistoryMenu : public QObject
+{
+  Q_OBJECT
+
+  private:
+    std::map<const Image*, SnapshotHistory> histories; // One per image
+
+  public slots:
+    bool Menu_History_Checkpoint(Image& image);
+    bool Menu_History_Undo(Image& image);
+    bool Menu_History_Reset(Image& image);
+    bool Menu_History_MemoryUsage(Image& image);
+};
@@ -0,0 +1,160 @@
+/***************************************************************************//**
+ * MorphologyMenu.cpp
+ *
+ * Author - Derek Stotz
+ *
+ * Date - October 18, 2026
+ *
+ * Details - Defines the grey-level morphology processes. The work is done in
+ * morphology.cpp.
+ *
+ ******************************************************************************/
+
+#include "MorphologyMenu.h"
+
+/***************************************************************************//**
+ * MorphologyMenu
+ * Author - Derek Stotz
+ *
+ * Starts with a 3x3 square structuring element.
+ ******************************************************************************/
+MorphologyMenu::MorphologyMenu() : shape(RectShape), width(3), height(3), angle(0)
+{
+}
+
+/***************************************************************************//**
+ * MorphologyMenu::morph
+ * Author - Derek Stotz
+ *
+ * Asks the user for a structuring element and applies an operation with it.
+ *
+ * Parameters -
+ *          image - the image object to manipulate.
+ *          op - the operation
+ *
+ * Returns
+ *          true if successful, false if not
+ ******************************************************************************/
+bool MorphologyMenu::morph(Image& image, morphOp op)
+{
+  StructElement se;
+
+  if (image.IsNull()) return false;
+
+  if (!Dialog("Structuring Element")
+        .Add(shape, "Shape (0 Rect, 1 Disk, 2 Line, 3 Diamond)", 0, 3)
+        .Add(width, "Width, Diameter or Length", 1, 1000)
+        .Add(height, "Rectangle Height", 1, 1000)
+        .Add(angle, "Line Angle", 0, 179).Show())
+    return false;
+
+  se.shape = (morphShape) shape;
+  se.width = width;
+  se.height = height;
+  se.angle = angle;
+
+  return morphImage(image, se, op);
+}
+
+/***************************************************************************//**
+ * Menu_Morphology_Erode
+ * Author - Derek Stotz
+ *
+ * Replaces each pixel with the smallest value under the structuring element.
+ *
+ * Parameters -
+            image - the image object to manipulate.
+ *
+ * Returns
+ *          true if successful, false if not
+ ******************************************************************************/
+bool MorphologyMenu::Menu_Morphology_Erode(Image& image)
+{
+  return morph(image, Erode);
+}
+
+/***************************************************************************//**
+ * Menu_Morphology_Dilate
+ * Author - Derek Stotz
+ *
+ * Replaces each pixel with the largest value under the structuring element.
+ *
+ * Parameters -
+            image - the image object to manipulate.
+ *
+ * Returns
+ *          true if successful, false if not
+ ******************************************************************************/
+bool MorphologyMenu::Menu_Morphology_Dilate(Image& image)
+{
+  return morph(image, Dilate);
+}
+
+/***************************************************************************//**
+ * Menu_Morphology_Open
+ * Author - Derek Stotz
+ *
+ * Erodes and then dilates, removing bright details smaller than the element.
+ *
+ * Parameters -
+            image - the image object to manipulate.
+ *
+ * Returns
+ *          true if successful, false if not
+ ******************************************************************************/
+bool MorphologyMenu::Menu_Morphology_Open(Image& image)
+{
+  return morph(image, Open);
+}
+
+/***************************************************************************//**
+ * Menu_Morphology_Close
+ * Author - Derek Stotz
+ *
+ * Dilates and then erodes, filling dark details smaller than the element.
+ *
+ * Parameters -
+            image - the image object to manipulate.
+ *
+ * Returns
+ *          true if successful, false if not
+ ******************************************************************************/
+bool MorphologyMenu::Menu_Morphology_Close(Image& image)
+{
+  return morph(image, Close);
+}
+
+/***************************************************************************//**
+ * Menu_Morphology_TopHat
+ * Author - Derek Stotz
+ *
+ * Keeps only the bright details smaller than the element: the image less its
+ * opening.
+ *
+ * Parameters -
+            image - the image object to manipulate.
+ *
+ * Returns
+ *          true if successful, false if not
+ ******************************************************************************/
+bool MorphologyMenu::Menu_Morphology_TopHat(Image& image)
+{
+  return morph(image, TopHat);
+}
+
+/***************************************************************************//**
+ * Menu_Morphology_Gradient
+ * Author - Derek Stotz
+ *
+ * Highlights edges: the dilation less the erosion.
+ *
+ * Parameters -
+            image - the image object to manipulate.
+ *
+ * Returns
+ *          true if successful, false if not
+ ******************************************************************************/
+bool MorphologyMenu::Menu_Morphology_Gradient(Image& image)
+{
+  return morph(image, Gradient);
+}
@@ -0,0 +1,46 @@
+/***************************************************************************//**
+ * MorphologyMenu.h
+ *
+ * Author - Derek Stotz
+ *
+ * Date - October 18, 2026
+ *
+ * Details - Contains the declaration for the MorphologyMenu class
+ *
+ ******************************************************************************/
+
+#include "morphology.h"
+
+/***************************************************************************//**
+ * MorphologyMenu
+ *
+ * Author - Derek Stotz
+ *
+ * Child of QObject class.
+ *
+ * Declares the grey-level morphology processes. Each asks for a structuring
+ * element, remembering the last one given.
+ ******************************************************************************/
+class MorphologyMenu : public QObject
+{
+  Q_OBJECT
+
+  private:
+    int shape;                          // Last shape, as a morphShape
+    int width;                          // Last width, diameter or length
+    int height;                         // Last rectangle height
+    int angle;                          // Last line angle
+
+    bool morph(Image& image, morphOp op);
+
+  public:
+    MorphologyMenu();
+
+  public slots:
+    bool Menu_Morphology_Erode(Image& image);
+    bool Menu_Morphology_Dilate(Image& image);
+    bool Menu_Morphology_Open(Image& image);
+    bool Menu_Morphology_Close(Image& image);
+    bool Menu_Morphology_TopHat(Image& image);
+    bool Menu_Morphology_Gradient(Image& image);
+};
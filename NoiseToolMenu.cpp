@@ -1,5 +1,14 @@
 #include "NoiseToolMenu.h"
 
+/***************************************************************************//**
+ * NoiseToolMenu
+ * Author - Derek Stotz
+ *
+ * Starts the noise seeds at 1.
+ ******************************************************************************/
+NoiseToolMenu::NoiseToolMenu() : seed(1)
+{
+}
 
 /***************************************************************************//**
  * Menu_NoiseTools_NoiseCleanFilter
@@ -24,7 +33,9 @@ bool NoiseToolMenu::Menu_NoiseTools_NoiseCleanFilter(Image& image)
  * Menu_NoiseTools_AddGaussianNoise
  * Author - Derek Stotz
  *
- * Adds Gaussian Noise to an image.  Asks the user for a standard devaition.
+ * Adds Gaussian Noise to an image.  Asks the user for a standard devaition
+ * and a seed.  The same seed always gives the same noise, and the seed offered
+ * next time is one higher.
  *
  * Parameters -
             image - the image object to manipulate.
@@ -37,18 +48,19 @@ bool NoiseToolMenu::Menu_NoiseTools_AddGaussianNoise(Image &image)
     double stddev = 0.0;
 
     // Propt user for standard deviation
-    if (!Dialog("Gaussian Noise").Add(stddev, "Standard Deviation").Show())
+    if (!Dialog("Gaussian Noise").Add(stddev, "Standard Deviation")
+                                 .Add(seed, "Seed").Show())
       return false;
 
-   gaussianNoise(image, stddev);
-   return true;
+    return addGaussianNoise(image, stddev, seed++);
 }
 
 /***************************************************************************//**
- * Menu_PointProcesses_ModifiedContrastStretch
+ * Menu_NoiseTools_AddImpulseNoise
  * Author - Derek Stotz
  *
- * Adds Impulse Noise to an image.
+ * Adds Impulse Noise to an image.  Asks the user for the percentage of pixels
+ * to turn black or white and a seed.
  *
  * Parameters -
             image - the image object to manipulate.
@@ -60,9 +72,38 @@ bool NoiseToolMenu::Menu_NoiseTools_AddImpulseNoise(Image &image)
 {
     int probability = 0;
 
-    // Propt user for standard deviation
-    if (!Dialog("Impulse Noise").Add(probability, "Standard Deviation", 0, 100).Show())
+    // Propt user for the percentage of pixels to hit
+    if (!Dialog("Impulse Noise").Add(probability, "Percent of Pixels", 0, 100)
+                                .Add(seed, "Seed").Show())
+      return false;
+
+    return addImpulseNoise(image, probability / 100.0, seed++);
+}
+
+/***************************************************************************//**
+ * Menu_NoiseTools_NonLocalMeans
+ * Author - Dan Andrus
+ *
+ * Removes noise with non-local means: each pixel is averaged with pixels in
+ * the search window whose surrounding patches look like its own, so edges
+ * and texture are kept. Asks for the noise level and the two window sizes.
+ *
+ * Parameters -
+            image - the image object to manipulate.
+ *
+ * Returns
+ *          true if successful, false if not
+ ******************************************************************************/
+bool NoiseToolMenu::Menu_NoiseTools_NonLocalMeans(Image& image)
+{
+    double sigma = 20.0;
+    int search = 7;
+    int patch = 2;
+
+    if (!Dialog("Non-Local Means").Add(sigma, "Noise Standard Deviation", 1.0, 100.0)
+                                  .Add(search, "Search Radius", 1, 30)
+                                  .Add(patch, "Patch Radius", 0, 10).Show())
       return false;
 
-    return impulseNoise(image, 100 - probability);
+    return nlMeansImage(image, sigma, search, patch);
 }
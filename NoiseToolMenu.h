@@ -10,6 +10,8 @@
  ******************************************************************************/
 
 #include "toolbox.h"
+#include "noise.h"
+#include "nlmeans.h"
 
 /***************************************************************************//**
  * NoiseToolMenu
@@ -19,15 +21,23 @@
  * Child of QObject class.
  *
  * Declares various neighborhood and noise generation processes which are used in
- * prog2.  The noise generation is done with built-in imagelib functions, and the
- * noise removal is done through a rank order filter.
+ * prog2.  The noise generation is done with seeded counter-based generators (see
+ * noise.cpp), and the noise removal is done through a rank order filter or
+ * non-local means.
  ******************************************************************************/
 class NoiseToolMenu : public QObject
 {
   Q_OBJECT
 
+  private:
+    int seed;                           // Seed offered for the next noise
+
+  public:
+    NoiseToolMenu();
+
   public slots:
     bool Menu_NoiseTools_NoiseCleanFilter(Image& image);
     bool Menu_NoiseTools_AddGaussianNoise(Image &image);
     bool Menu_NoiseTools_AddImpulseNoise(Image &image);
+    bool Menu_NoiseTools_NonLocalMeans(Image& image);
 };
@@ -11,6 +11,10 @@
  ******************************************************************************/
 
 #include "PointProcessor.h"
+#include "histogram.h"
+#include "lut.h"
+#include "imagestats.h"
+#include "clahe.h"
 
 /***************************************************************************//**
  * Menu_PointProcesses_ModifiedContrastStretch
@@ -44,8 +48,16 @@ bool PointProcessor::Menu_PointProcesses_ConvertToGreyscale(Image& image)
 bool PointProcessor::Menu_PointProcesses_ApplyBinaryThreshold(Image& image)
 {
     int threshold = 0;
+    PointLut lut;
+
     getParams(threshold);
-    return binaryThreshold(image, threshold);
+
+    // Everything below the threshold goes black, everything else white
+    for (int i = 0; i < 256; i++)
+      lut.table[i] = (i < threshold) ? 0 : 255;
+    lut.target = LutGray;
+
+    return applyLut(image, lut);
 }
 
 /***************************************************************************//**
@@ -72,17 +84,11 @@ bool PointProcessor::Menu_PointProcesses_Equalize(Image& image)
   int tally = 0;
   int tmp;
   
-  unsigned char lutable[256];
-  int histogram[256] = {0};
+  PointLut lut;
+  uint histogram[256];
   
   // Build histogram
-  for (int i = 0; i < rows; i++)
-  {
-    for (int j = 0; j < cols; j++)
-    {
-      histogram[image[i][j].Intensity()]++;
-    }
-  }
+  imageHistogram(image, IntensityChannel, histogram);
   
   
   // Build lookup table based on histogram
@@ -92,19 +98,12 @@ bool PointProcessor::Menu_PointProcesses_Equalize(Image& image)
     tmp = (int) (tally / (total / 256.0));
     if (tmp < 0) tmp = 0;
     if (tmp > 255) tmp = 255;
-    lutable[i] = tmp;
+    lut.table[i] = tmp;
   }
+  lut.target = LutIntensity;
   
-  for (int i = 0; i < rows; i++)
-  {
-    for (int j = 0; j < cols; j++)
-    {
-      // Pseudocolor each pixel based on intensity
-      image[i][j].SetIntensity(lutable[image[i][j].Intensity()]);
-    }
-  }
-  
-  return true;
+  // Pseudocolor each pixel based on intensity
+  return applyLut(image, lut);
 }
 
 
@@ -135,8 +134,8 @@ bool PointProcessor::Menu_PointProcesses_EqualizeWithClipping
   int tmp;
   double max;
   
-  unsigned char lutable[256];
-  int histogram[256] = {0};
+  PointLut lut;
+  uint histogram[256];
   
   // Propt user for threshold value
   max = 0;
@@ -148,13 +147,7 @@ bool PointProcessor::Menu_PointProcesses_EqualizeWithClipping
     return false;
   
   // Build histogram
-  for (int i = 0; i < rows; i++)
-  {
-    for (int j = 0; j < cols; j++)
-    {
-      histogram[image[i][j].Intensity()]++;
-    }
-  }
+  imageHistogram(image, IntensityChannel, histogram);
   
   // Format max for histogram
   max = (int) (total * (max / 100));
@@ -175,19 +168,73 @@ bool PointProcessor::Menu_PointProcesses_EqualizeWithClipping
     tmp = (int) (tally / (total / 256.0));
     if (tmp < 0) tmp = 0;
     if (tmp > 255) tmp = 255;
-    lutable[i] = (unsigned char) tmp;
+    lut.table[i] = (unsigned char) tmp;
   }
+  lut.target = LutIntensity;
   
-  for (int i = 0; i < rows; i++)
-  {
-    for (int j = 0; j < cols; j++)
-    {
-      // Pseudocolor each pixel based on intensity
-      image[i][j].SetIntensity(lutable[image[i][j].Intensity()]);
-    }
-  }
+  // Pseudocolor each pixel based on intensity
+  return applyLut(image, lut);
+}
+
+/***************************************************************************//**
+ * Menu_PointProcesses_AdaptiveEqualize
+ * Author - Derek Stotz
+ *
+ * Contrast-limited adaptive histogram equalization: the image is split into
+ * tiles, each tile's histogram is clipped and equalized, and each pixel is
+ * mapped by a blend of the nearest tiles' tables. Brings out detail in dark
+ * and bright areas at once.
+ *
+ * Parameters -
+            image - the image object to manipulate.
+ *
+ * Returns
+ *          true if successful, false if not
+ ******************************************************************************/
+bool PointProcessor::Menu_PointProcesses_AdaptiveEqualize(Image& image)
+{
+  if (image.IsNull())
+    return false;
+  
+  int tiles_x = 8;
+  int tiles_y = 8;
+  double clip = 3.0;
+  
+  if (!Dialog("Adaptive Equalization").Add(tiles_x, "Tiles Across", 1, 64)
+                                      .Add(tiles_y, "Tiles Down", 1, 64)
+                                      .Add(clip, "Clip Limit", 1.0, 256.0).Show())
+    return false;
+  
+  return claheImage(image, tiles_x, tiles_y, 0, clip);
+}
+
+/***************************************************************************//**
+ * Menu_PointProcesses_SlidingWindowEqualize
+ * Author - Derek Stotz
+ *
+ * Contrast-limited adaptive histogram equalization with a window centered on
+ * every pixel instead of fixed tiles. Takes the same time for any window
+ * size.
+ *
+ * Parameters -
+            image - the image object to manipulate.
+ *
+ * Returns
+ *          true if successful, false if not
+ ******************************************************************************/
+bool PointProcessor::Menu_PointProcesses_SlidingWindowEqualize(Image& image)
+{
+  if (image.IsNull())
+    return false;
+  
+  int radius = 32;
+  double clip = 3.0;
   
-  return true;
+  if (!Dialog("Sliding Window Equalization").Add(radius, "Window Radius", 1, 500)
+                                            .Add(clip, "Clip Limit", 1.0, 256.0).Show())
+    return false;
+  
+  return claheImage(image, 0, 0, radius, clip);
 }
 
 /***************************************************************************//**
@@ -204,32 +251,20 @@ bool PointProcessor::Menu_PointProcesses_EqualizeWithClipping
  ******************************************************************************/
 bool PointProcessor::Menu_PointProcesses_AutoContrastStretch(Image& image)
 {
-    int rows = image.Height();
-    int cols = image.Width();
-
-    uchar min_i = 255;
-    uchar max_i = 0;
-
-    for (int i = 0; i < rows; i++)
-    {
-        for (int j = 0; j < cols; j++)
-        {
-            min_i = std::min(min_i, image[i][j].Intensity());
-            max_i = std::max(max_i, image[i][j].Intensity());
-        }
-    }
-
-    for (int i = 0; i < rows; i++)
-    {
-      for (int j = 0; j < cols; j++)
-      {
-          image[i][j].SetRed((255/(max_i - min_i)) * (image[i][j].Red() - min_i));
-          image[i][j].SetGreen((255/(max_i - min_i)) * (image[i][j].Green() - min_i));
-          image[i][j].SetBlue((255/(max_i - min_i)) * (image[i][j].Blue() - min_i));
-      }
-    }
+    ImageStats stats;
+    PointLut lut;
 
-    return true;
+    // one counting pass gives the min and max intensity
+    if (!imageStats(image, stats))
+      return false;
+
+    // A flat image has nothing to stretch
+    if (stats.max <= stats.min)
+      return false;
+
+    lutStretch(lut, stats.min, stats.max);
+
+    return applyLut(image, lut);
 }
 
 /***************************************************************************//**
@@ -247,67 +282,99 @@ bool PointProcessor::Menu_PointProcesses_AutoContrastStretch(Image& image)
  ******************************************************************************/
 bool PointProcessor::Menu_PointProcesses_ModifiedContrastStretch(Image& image)
 {
-    int rows = image.Height();
-    int cols = image.Width();
-    int n_pixels = rows*cols;
     int min_p = 0;
     int max_p = 0;
-    std::vector<uint>histogram = std::vector<uint>(256);
+    int min_i;
+    int max_i;
+    ImageStats stats;
+    PointLut lut;
 
     // Propt user for threshold value
     if (!Dialog("Gamma Correction").Add(min_p, "Minimum Percentage", 0, 100).Add(max_p, "Maximum Percentage", 0, 100).Show())
       return false;
 
-    uchar min_i = 255;
-    uchar max_i = 0;
-
-    // create list of intensity values
-    for (int i = 0; i < rows; i++)
-    {
-      for (int j = 0; j < cols; j++)
-      {
-          histogram[image[i][j].Intensity()]++;
-      }
-    }
-
-    min_p = (min_p /100.0) * n_pixels;
-    max_p = (max_p /100.0) * n_pixels;
-
-    // find the min_i by subtracting pixel counts from the pixels to ignore
-    bool done = false;
-    for (int i = 0; !done && i < 256; i++)
-    {
-        min_p -= histogram[i];
-        if (min_p <= 0)\
-        {
-            min_i = i;
-            done = true;
-        }
-    }
-
-    // find the max_i by subtracting pixel counts from the pixels to ignore
-    done = false;
-    for (int i = 255; !done && i > 0; i--)
-    {
-        max_p -= histogram[i];
-        if (max_p <= 0)\
-        {
-            max_i = i;
-            done = true;
-        }
-    }
-
-    for (int i = 0; i < rows; i++)
-    {
-      for (int j = 0; j < cols; j++)
-      {
-          image[i][j].SetRed((255/(max_i - min_i)) * (image[i][j].Red() - min_i));
-          image[i][j].SetGreen((255/(max_i - min_i)) * (image[i][j].Green() - min_i));
-          image[i][j].SetBlue((255/(max_i - min_i)) * (image[i][j].Blue() - min_i));
-      }
-    }
+    // one counting pass gives the intensity histogram
+    if (!imageStats(image, stats))
+      return false;
 
-    return true;
+    // find the min_i and max_i by ignoring the requested share of pixels
+    min_i = statsLowerCut(stats, min_p);
+    max_i = statsUpperCut(stats, max_p);
+
+    // A flat image has nothing to stretch
+    if (max_i <= min_i)
+      return false;
+
+    lutStretch(lut, min_i, max_i);
+
+    return applyLut(image, lut);
+}
+
+/***************************************************************************//**
+ * Menu_PointProcesses_CombinedAdjustment
+ * Author - Derek Stotz
+ *
+ * Applies brightness, contrast, gamma, negation and posterization in one go.
+ * Each adjustment is built as its own lookup table and the chain folds them
+ * together, so all five cost a single pass over the image.
+ *
+ * Parameters -
+            image - the image object to manipulate.
+ *
+ * Returns
+ *          true if successful, false if not
+ ******************************************************************************/
+bool PointProcessor::Menu_PointProcesses_CombinedAdjustment(Image& image)
+{
+    if (image.IsNull())
+      return false;
+
+    int brightness = 0;
+    int contrast = 100;
+    double gamma = 1.0;
+    int negate = 0;
+    int levels = 256;
+    int values[256];
+    PointLut lut;
+    LutChain chain;
+
+    // Propt user for the adjustments
+    if (!Dialog("Combined Adjustment").Add(brightness, "Brightness", -255, 255)
+        .Add(contrast, "Contrast Percentage", 0, 1000).Add(gamma, "Gamma", 0.01, 10.0)
+        .Add(negate, "Negate (0 or 1)", 0, 1).Add(levels, "Levels", 2, 256).Show())
+      return false;
+
+    // brightness shifts every value
+    for (int i = 0; i < 256; i++)
+        values[i] = i + brightness;
+    lutClip(lut, values, LutChannels);
+    chain.push(lut);
+
+    // contrast scales values away from the middle gray
+    for (int i = 0; i < 256; i++)
+        values[i] = 128 + ((i - 128) * contrast) / 100;
+    lutClip(lut, values, LutChannels);
+    chain.push(lut);
+
+    // gamma correction on normalized values
+    for (int i = 0; i < 256; i++)
+        values[i] = (int) (255 * pow(i / 255.0, 1.0 / gamma) + 0.5);
+    lutClip(lut, values, LutChannels);
+    chain.push(lut);
+
+    // negation
+    for (int i = 0; i < 256; i++)
+        values[i] = negate ? 255 - i : i;
+    lutClip(lut, values, LutChannels);
+    chain.push(lut);
+
+    // posterize down to the requested number of evenly spaced levels
+    for (int i = 0; i < 256; i++)
+        values[i] = ((i * levels / 256) * 255) / (levels - 1);
+    lutClip(lut, values, LutChannels);
+    chain.push(lut);
+
+    return chain.apply(image);
 }
 
 /***************************************************************************//**
@@ -34,8 +34,11 @@ class PointProcessor : public QObject
     bool Menu_PointProcesses_ApplyBinaryThreshold(Image& image);
     bool Menu_PointProcesses_Equalize(Image& image);
     bool Menu_PointProcesses_EqualizeWithClipping(Image& image);
+    bool Menu_PointProcesses_AdaptiveEqualize(Image& image);
+    bool Menu_PointProcesses_SlidingWindowEqualize(Image& image);
     bool Menu_PointProcesses_AutoContrastStretch(Image& image);
     bool Menu_PointProcesses_ModifiedContrastStretch(Image& image);
+    bool Menu_PointProcesses_CombinedAdjustment(Image& image);
     bool Menu_PointProcesses_ViewImageHistogram(Image &image);
 };
 
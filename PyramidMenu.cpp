@@ -0,0 +1,225 @@
+/***************************************************************************//**
+ * PyramidMenu.cpp
+ *
+ * Author - Dan Andrus
+ *
+ * Date - October 18, 2026
+ *
+ * Details - Defines the multi-resolution processes, which run the existing
+ * filters on a level of the image pyramid.
+ *
+ ******************************************************************************/
+
+#include "PyramidMenu.h"
+#include "EdgeDetectionMenu.h"
+
+/***************************************************************************//**
+ * sobelMagnitude
+ * Author - Dan Andrus
+ *
+ * Adapter so the Sobel magnitude process can be passed to filterAtLevel.
+ ******************************************************************************/
+static bool sobelMagnitude(Image& image)
+{
+  EdgeDetectionMenu edm;
+  return edm.Menu_EdgeDetection_SobelMagnitude(image);
+}
+
+/***************************************************************************//**
+ * kirschMagnitude
+ * Author - Dan Andrus
+ *
+ * Adapter so the Kirsch magnitude process can be passed to filterAtLevel.
+ ******************************************************************************/
+static bool kirschMagnitude(Image& image)
+{
+  EdgeDetectionMenu edm;
+  return edm.Menu_EdgeDetection_KirschMagnitude(image);
+}
+
+/***************************************************************************//**
+ * medianFilter
+ * Author - Dan Andrus
+ *
+ * Adapter so the rank order median filter can be passed to filterAtLevel.
+ ******************************************************************************/
+static bool medianFilter(Image& image)
+{
+  return filterStatistic(image, Median);
+}
+
+/***************************************************************************//**
+ * PyramidMenu::askLevel
+ * Author - Dan Andrus
+ *
+ * Asks the user which pyramid level to work on.
+ *
+ * Parameters -
+ *          level - receives the level, 0 being full size
+ *
+ * Returns
+ *          true if the user chose a level, false if they cancelled
+ ******************************************************************************/
+bool PyramidMenu::askLevel(int& level)
+{
+  level = 1;
+  return Dialog("Pyramid Level").Add(level, "Level", 0, 10).Show();
+}
+
+/***************************************************************************//**
+ * PyramidMenu::filterAtLevel
+ * Author - Dan Andrus
+ *
+ * Runs a filter on one level of the image's pyramid and expands the result
+ * back into the image.
+ *
+ * Parameters -
+ *          image - the image object to manipulate.
+ *          filter - the process to run on the pyramid level
+ *
+ * Returns
+ *          true if successful, false if not
+ ******************************************************************************/
+bool PyramidMenu::filterAtLevel(Image& image, bool (*filter)(Image&))
+{
+  if (image.IsNull()) return false;
+
+  int level;
+  Image coarse;
+  ImagePlanes result;
+  ImagePlanes full;
+  vector<Rect> regions;
+  bool filtered;
+
+  if (!askLevel(level) || !pyramid.update(image, level))
+    return false;
+
+  // Run the filter on the coarse level as an ordinary image. The active
+  // regions are in full size coordinates, so the whole level is filtered.
+  regions = activeRegions();
+  clearActiveRegions();
+  filtered = imageFromPlanes(pyramid.gaussianLevel(level), coarse) && filter(coarse);
+  setActiveRegions(regions);
+  if (!filtered)
+    return false;
+
+  // Bring the result back up to full size
+  unpackImage(coarse, result);
+  if (!expandToSize(result, image.Width(), image.Height(), full))
+    return false;
+  packImage(full, image);
+
+  return true;
+}
+
+/***************************************************************************//**
+ * Menu_Pyramid_ViewGaussianLevel
+ * Author - Dan Andrus
+ *
+ * Replaces the image with one level of its Gaussian pyramid, expanded back to
+ * full size.
+ *
+ * Parameters -
+ *          image - the image object to manipulate.
+ *
+ * Returns
+ *          true if successful, false if not
+ ******************************************************************************/
+bool PyramidMenu::Menu_Pyramid_ViewGaussianLevel(Image& image)
+{
+  if (image.IsNull()) return false;
+
+  int level;
+  ImagePlanes full;
+
+  if (!askLevel(level) || !pyramid.update(image, level))
+    return false;
+
+  if (!expandToSize(pyramid.gaussianLevel(level), image.Width(), image.Height(), full))
+    return false;
+  packImage(full, image);
+
+  return true;
+}
+
+/***************************************************************************//**
+ * Menu_Pyramid_ViewLaplacianLevel
+ * Author - Dan Andrus
+ *
+ * Replaces the image with one level of its Laplacian pyramid, expanded back
+ * to full size. Zero detail shows as mid gray.
+ *
+ * Parameters -
+ *          image - the image object to manipulate.
+ *
+ * Returns
+ *          true if successful, false if not
+ ******************************************************************************/
+bool PyramidMenu::Menu_Pyramid_ViewLaplacianLevel(Image& image)
+{
+  if (image.IsNull()) return false;
+
+  int level;
+  ImagePlanes full;
+
+  if (!askLevel(level) || !pyramid.update(image, level))
+    return false;
+
+  if (!expandToSize(pyramid.laplacianLevel(level), image.Width(), image.Height(), full))
+    return false;
+  packImage(full, image);
+
+  return true;
+}
+
+/***************************************************************************//**
+ * Menu_Pyramid_SobelMagnitude
+ * Author - Dan Andrus
+ *
+ * Highlights coarse-scale edges by running Sobel on a pyramid level.
+ *
+ * Parameters -
+ *          image - the image object to manipulate.
+ *
+ * Returns
+ *          true if successful, false if not
+ ******************************************************************************/
+bool PyramidMenu::Menu_Pyramid_SobelMagnitude(Image& image)
+{
+  return filterAtLevel(image, sobelMagnitude);
+}
+
+/***************************************************************************//**
+ * Menu_Pyramid_KirschMagnitude
+ * Author - Dan Andrus
+ *
+ * Highlights coarse-scale edges by running Kirsch on a pyramid level.
+ *
+ * Parameters -
+ *          image - the image object to manipulate.
+ *
+ * Returns
+ *          true if successful, false if not
+ ******************************************************************************/
+bool PyramidMenu::Menu_Pyramid_KirschMagnitude(Image& image)
+{
+  return filterAtLevel(image, kirschMagnitude);
+}
+
+/***************************************************************************//**
+ * Menu_Pyramid_MedianFilter
+ * Author - Dan Andrus
+ *
+ * Applies a median filter on a pyramid level. A width w at level k covers
+ * about the same area as a width w * 2^k filter at full size.
+ *
+ * Parameters -
+ *          image - the image object to manipulate.
+ *
+ * Returns
+ *          true if successful, false if not
+ ******************************************************************************/
+bool PyramidMenu::Menu_Pyramid_MedianFilter(Image& image)
+{
+  return filterAtLevel(image, medianFilter);
+}
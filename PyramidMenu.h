@@ -0,0 +1,41 @@
+/***************************************************************************//**
+ * PyramidMenu.h
+ *
+ * Author - Dan Andrus
+ *
+ * Date - October 18, 2026
+ *
+ * Details - Contains the declaration for the PyramidMenu class
+ *
+ ******************************************************************************/
+
+#include "pyramid.h"
+
+/***************************************************************************//**
+ * PyramidMenu
+ *
+ * Author - Dan Andrus
+ *
+ * Child of QObject class.
+ *
+ * Declares multi-resolution processes. Filters are run on a coarser level of
+ * the image's Gaussian pyramid and the result is expanded back to full size.
+ * The pyramid is kept between calls, so working on the same image again does
+ * not rebuild it.
+ ******************************************************************************/
+class PyramidMenu : public QObject
+{
+  Q_OBJECT
+
+  private:
+    ImagePyramid pyramid;
+    bool askLevel(int& level);
+    bool filterAtLevel(Image& image, bool (*filter)(Image&));
+
+  public slots:
+    bool Menu_Pyramid_ViewGaussianLevel(Image& image);
+    bool Menu_Pyramid_ViewLaplacianLevel(Image& image);
+    bool Menu_Pyramid_SobelMagnitude(Image& image);
+    bool Menu_Pyramid_KirschMagnitude(Image& image);
+    bool Menu_Pyramid_MedianFilter(Image& image);
+};
@@ -1,5 +1,11 @@
 
 #include "RankOrderFilterMenu.h"
+#include "rankorder.h"
+#include "pyramid.h"
+#include <cstring>
+
+// Largest proxy the preview renders, in pixels
+static const int PROXY_PIXELS = 512 * 512;
 
 /***************************************************************************//**
  * Menu_RankOrderFilers_MeanFilter
@@ -120,3 +126,92 @@ bool RankOrderFilterMenu::Menu_RankOrderFilters_PlusShapedMedianFilter(Image& im
   return result;
 }
 
+/***************************************************************************//**
+ * Menu_RankOrderFilters_MedianPreview
+ * Author - Derek Stotz
+ *
+ * Shows a quick preview of a median filter. The image is reduced to a proxy
+ * of at most PROXY_PIXELS pixels, filtered there with the width scaled down to
+ * match, and expanded back for display. The full-resolution median starts on
+ * a background thread; ApplyFullResolution swaps it in.
+ *
+ * Parameters -
+            image - the image object to manipulate.
+ *
+ * Returns
+ *          true if successful, false if not
+ ******************************************************************************/
+bool RankOrderFilterMenu::Menu_RankOrderFilters_MedianPreview(Image& image)
+{
+  if (image.IsNull()) return false;
+
+  int mask_w = 3;
+  int level;
+  int proxy_w;
+  ImagePlanes full;
+  ImagePlanes proxy;
+  ImagePlanes next;
+  ImagePlanes filtered;
+
+  // Ask the user for the dimensions of the filer
+  if (!Dialog("Median Preview").Add(mask_w, "Filter Width").Show() || mask_w < 2)
+    return false;
+
+  // Start the real thing first so it runs while the proxy is made
+  unpackImage(image, full);
+  render.start(full, medianBand, mask_w);
+
+  // Reduce to proxy size, scaling the filter width with the image
+  level = proxyLevel(full.width, full.height, PROXY_PIXELS);
+  proxy = full;
+  for (int k = 0; k < level; k++)
+  {
+    pyramidReduce(proxy, next);
+    proxy = next;
+  }
+  proxy_w = std::max(1, (mask_w + (1 << level) / 2) >> level);
+
+  if (!medianPlanes(proxy, filtered, proxy_w) ||
+      !expandToSize(filtered, full.width, full.height, preview))
+    return false;
+
+  packImage(preview, image);
+  return true;
+}
+
+/***************************************************************************//**
+ * Menu_RankOrderFilters_ApplyFullResolution
+ * Author - Derek Stotz
+ *
+ * Replaces the preview with the full-resolution median, waiting for it if it
+ * has not finished. If the image was changed after the preview was shown, the
+ * render is thrown away rather than overwriting those changes.
+ *
+ * Parameters -
+            image - the image object to manipulate.
+ *
+ * Returns
+ *          true if successful, false if not
+ ******************************************************************************/
+bool RankOrderFilterMenu::Menu_RankOrderFilters_ApplyFullResolution(Image& image)
+{
+  if (image.IsNull() || !render.active()) return false;
+
+  ImagePlanes current;
+  ImagePlanes result;
+
+  if (!render.finish(result))
+    return false;
+
+  // Only replace the preview we put there
+  unpackImage(image, current);
+  if (current.width != preview.width || current.height != preview.height ||
+      memcmp(&current.red[0], &preview.red[0], current.red.size()) != 0 ||
+      memcmp(&current.green[0], &preview.green[0], current.green.size()) != 0 ||
+      memcmp(&current.blue[0], &preview.blue[0], current.blue.size()) != 0)
+    return false;
+
+  packImage(result, image);
+  preview = ImagePlanes();
+  return true;
+}
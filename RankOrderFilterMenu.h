@@ -10,6 +10,7 @@
  ******************************************************************************/
 
 #include "toolbox.h"
+#include "preview.h"
 
 /***************************************************************************//**
  * RankOrderFilterMenu
@@ -21,15 +22,24 @@
  * Declares various neighborhood proccess for Rank Order filters with specifiable
  * filter sizes.  Pixels filtered through these will be set to whatever statistically
  * signifcant value in the neighborhood specified.
+ *
+ * The median preview renders a low-resolution proxy right away and the full
+ * image on a background thread, which replaces the proxy when applied.
  ******************************************************************************/
 class RankOrderFilterMenu : public QObject
 {
   Q_OBJECT
 
+  private:
+    BackgroundRender render;            // Full-resolution median in progress
+    ImagePlanes preview;                // The proxy the image was given
+
   public slots:
     bool Menu_RankOrderFilters_MeanFilter(Image& image);
     bool Menu_RankOrderFilters_MedianFilter(Image& image);
     bool Menu_RankOrderFilters_MinimumFilter(Image& image);
     bool Menu_RankOrderFilters_MaximumFilter(Image& image);
     bool Menu_RankOrderFilters_PlusShapedMedianFilter(Image& image);
+    bool Menu_RankOrderFilters_MedianPreview(Image& image);
+    bool Menu_RankOrderFilters_ApplyFullResolution(Image& image);
 };
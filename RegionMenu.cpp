@@ -0,0 +1,112 @@
+/***************************************************************************//**
+ * RegionMenu.cpp
+ *
+ * Author - Dan Andrus
+ *
+ * Date - October 18, 2026
+ *
+ * Details - Defines the processes that restrict filtering to regions of the
+ * image. None of them change the image itself.
+ *
+ ******************************************************************************/
+
+#include "RegionMenu.h"
+
+/***************************************************************************//**
+ * RegionMenu::askRect
+ * Author - Dan Andrus
+ *
+ * Asks the user for a rectangle of the image.
+ *
+ * Parameters -
+ *          image - the image the rectangle lies in
+ *          r - receives the rectangle, clipped to the image
+ *
+ * Returns
+ *          true if the user gave a rectangle that overlaps the image
+ ******************************************************************************/
+bool RegionMenu::askRect(Image& image, Rect& r)
+{
+  if (image.IsNull()) return false;
+
+  int x = 0;
+  int y = 0;
+  int w = image.Width() / 2;
+  int h = image.Height() / 2;
+
+  if (!Dialog("Region").Add(x, "Left", 0, image.Width() - 1)
+                       .Add(y, "Top", 0, image.Height() - 1)
+                       .Add(w, "Width", 1, image.Width())
+                       .Add(h, "Height", 1, image.Height()).Show())
+    return false;
+
+  r = clipRect(makeRect(x, y, w, h), image.Width(), image.Height());
+  return !emptyRect(r);
+}
+
+/***************************************************************************//**
+ * Menu_Region_SetRegion
+ * Author - Dan Andrus
+ *
+ * Restricts the filters to a single rectangle of the image.
+ *
+ * Parameters -
+            image - the image the region lies in.
+ *
+ * Returns
+ *          false, since the image is not changed
+ ******************************************************************************/
+bool RegionMenu::Menu_Region_SetRegion(Image& image)
+{
+  Rect r;
+
+  if (askRect(image, r))
+  {
+    clearActiveRegions();
+    addActiveRegion(r);
+  }
+
+  return false;
+}
+
+/***************************************************************************//**
+ * Menu_Region_AddRegion
+ * Author - Dan Andrus
+ *
+ * Adds another rectangle to the regions the filters are restricted to.
+ *
+ * Parameters -
+            image - the image the region lies in.
+ *
+ * Returns
+ *          false, since the image is not changed
+ ******************************************************************************/
+bool RegionMenu::Menu_Region_AddRegion(Image& image)
+{
+  Rect r;
+
+  if (askRect(image, r))
+    addActiveRegion(r);
+
+  return false;
+}
+
+/***************************************************************************//**
+ * Menu_Region_ClearRegions
+ * Author - Dan Andrus
+ *
+ * Lets the filters process the whole image again.
+ *
+ * Parameters -
+            image - the image object (unused).
+ *
+ * Returns
+ *          false, since the image is not changed
+ ******************************************************************************/
+bool RegionMenu::Menu_Region_ClearRegions(Image& image)
+{
+  Q_UNUSED(image);
+
+  clearActiveRegions();
+  return false;
+}
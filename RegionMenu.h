@@ -0,0 +1,35 @@
+/***************************************************************************//**
+ * RegionMenu.h
+ *
+ * Author - Dan Andrus
+ *
+ * Date - October 18, 2026
+ *
+ * Details - Contains the declaration for the RegionMenu class
+ *
+ ******************************************************************************/
+
+#include "region.h"
+
+/***************************************************************************//**
+ * RegionMenu
+ *
+ * Author - Dan Andrus
+ *
+ * Child of QObject class.
+ *
+ * Declares processes that pick the rectangles of the image the neighborhood
+ * filters are restricted to. With no regions set, whole images are filtered.
+ ******************************************************************************/
+class RegionMenu : public QObject
+{
+  Q_OBJECT
+
+  private:
+    bool askRect(Image& image, Rect& r);
+
+  public slots:
+    bool Menu_Region_SetRegion(Image& image);
+    bool Menu_Region_AddRegion(Image& image);
+    bool Menu_Region_ClearRegions(Image& image);
+};
@@ -1,5 +1,7 @@
 
 #include "SmoothingMenu.h"
+#include "gaussian.h"
+#include "bilateral.h"
 
 /***************************************************************************//**
 * Menu_Smoothing_3x3SmoothingFilter
@@ -37,3 +39,180 @@ result = filterAverage(image, mask, 3, 3);
 dealloc2d(mask, 3);
 return result;
 }
+
+/***************************************************************************//**
+* Menu_Smoothing_GaussianSmoothing
+* Author - Dan Andrus
+*
+* Smooths an image with a Gaussian of any standard deviation. Uses a recursive
+* filter, so large sigmas take no longer than small ones. Only the active
+* regions are smoothed, reading three sigmas around them.
+*
+* Parameters -
+* image - the image object to manipulate.
+*
+* Returns
+* true if successful, false if not
+******************************************************************************/
+bool SmoothingMenu::Menu_Smoothing_GaussianSmoothing(Image& image)
+{
+  // Make sure image isn't null
+  if (image.IsNull()) return false;
+
+  double sigma = 2.0;
+  ImagePlanes planes;                   // The part of the image read
+  vector<Rect> rects;                   // Regions to smooth
+  Rect box;                             // Part of the image that is read
+
+  // Ask the user for the amount of smoothing
+  if (!Dialog("Gaussian Smoothing").Add(sigma, "Sigma", 0.5, 100.0).Show())
+    return false;
+
+  rects = imageRegions(image.Width(), image.Height());
+  if (rects.empty()) return true;
+
+  // Beyond three sigmas the Gaussian weights are negligible
+  box = padRect(boundingRect(rects), (int) ceil(3 * sigma),
+                image.Width(), image.Height());
+  if (!unpackRegion(image, box, planes)) return false;
+  if (!gaussianSmooth(planes, sigma))
+    return false;
+
+  packRegions(planes, box.x, box.y, rects, image);
+
+  return true;
+}
+
+/***************************************************************************//**
+* Menu_Smoothing_BilateralFilter
+* Author - Dan Andrus
+*
+* Smooths an image while keeping edges: each pixel is averaged with nearby
+* pixels of similar value. Runs on a bilateral grid, so large spatial sigmas
+* are faster than small ones.
+*
+* Parameters -
+* image - the image object to manipulate.
+*
+* Returns
+* true if successful, false if not
+******************************************************************************/
+bool SmoothingMenu::Menu_Smoothing_BilateralFilter(Image& image)
+{
+  // Make sure image isn't null
+  if (image.IsNull()) return false;
+
+  double sigma_s = 8.0;
+  double sigma_r = 20.0;
+
+  // Ask the user how far to smooth and how different a value may be
+  if (!Dialog("Bilateral Filter")
+        .Add(sigma_s, "Spatial Sigma", 1.0, 100.0)
+        .Add(sigma_r, "Range Sigma", 1.0, 255.0).Show())
+    return false;
+
+  return bilateralImage(image, sigma_s, sigma_r);
+}
+
+/***************************************************************************//**
+* SmoothingMenu::guided
+* Author - Derek Stotz
+*
+* Asks for the guided filter settings and applies it, either smoothing or
+* boosting the detail the smoothing would remove.
+*
+* Parameters -
+* image - the image object to manipulate.
+* enhance - if true, boosts detail. If false, smooths
+*
+* Returns
+* true if successful, false if not
+******************************************************************************/
+bool SmoothingMenu::guided(Image& image, bool enhance)
+{
+  // Make sure image isn't null
+  if (image.IsNull()) return false;
+
+  int radius = 8;
+  int edge = 20;
+  int subsample = 1;
+  int use_guide = 0;
+  double detail = enhance ? 3.0 : 0.0;
+
+  Dialog dialog(enhance ? "Guided Detail Enhance" : "Guided Filter");
+  dialog.Add(radius, "Radius", 1, 200)
+        .Add(edge, "Edge Strength (gray levels)", 1, 255)
+        .Add(subsample, "Subsample (1 for exact)", 1, 16);
+  if (enhance)
+    dialog.Add(detail, "Detail Gain", 1.0, 10.0);
+  else
+    dialog.Add(use_guide, "Guide (0 Self, 1 Stored Guide Image)", 0, 1);
+  if (!dialog.Show())
+    return false;
+
+  // The stored guide has to line up with the image
+  if (use_guide && (guide.width != image.Width() || guide.height != image.Height()))
+    return false;
+
+  // Windows whose guide varies less than the edge strength are smoothed
+  return guidedImage(image, use_guide ? &guide : 0, radius,
+                     (double) edge * edge, subsample, detail);
+}
+
+/***************************************************************************//**
+* Menu_Smoothing_GuidedFilter
+* Author - Derek Stotz
+*
+* Smooths an image while keeping edges, with the guided filter. Each channel
+* can guide itself, or the stored guide image can decide where the edges are.
+* Takes the same time for any radius.
+*
+* Parameters -
+* image - the image object to manipulate.
+*
+* Returns
+* true if successful, false if not
+******************************************************************************/
+bool SmoothingMenu::Menu_Smoothing_GuidedFilter(Image& image)
+{
+  return guided(image, false);
+}
+
+/***************************************************************************//**
+* Menu_Smoothing_GuidedDetailEnhance
+* Author - Derek Stotz
+*
+* Boosts fine detail without haloes around strong edges, by amplifying what
+* the self-guided filter removes.
+*
+* Parameters -
+* image - the image object to manipulate.
+*
+* Returns
+* true if successful, false if not
+******************************************************************************/
+bool SmoothingMenu::Menu_Smoothing_GuidedDetailEnhance(Image& image)
+{
+  return guided(image, true);
+}
+
+/***************************************************************************//**
+* Menu_Smoothing_SetGuideImage
+* Author - Derek Stotz
+*
+* Stores the current image as the guide for the guided filter. Its intensity
+* guides every channel of images of the same size.
+*
+* Parameters -
+* image - the image to store.
+*
+* Returns
+* false, since the image is not changed
+******************************************************************************/
+bool SmoothingMenu::Menu_Smoothing_SetGuideImage(Image& image)
+{
+  if (image.IsNull()) return false;
+
+  unpackImage(image, guide);
+  return false;
+}
@@ -10,6 +10,7 @@
  ******************************************************************************/
 
 #include "toolbox.h"
+#include "guided.h"
 
 /***************************************************************************//**
  * SmoothingMenu
@@ -18,14 +19,25 @@
  *
  * Child of QObject class.
  *
- * Declares one smoothing function, could be extended to include Gaussian smoothing
- * for extra credit.
+ * Declares the smoothing functions: the fixed 3x3 smoothing mask, a recursive
+ * Gaussian smooth with a user-chosen sigma, and the edge-preserving bilateral
+ * and guided filters. A stored guide image can steer the guided filter.
  ******************************************************************************/
 class SmoothingMenu : public QObject
 {
   Q_OBJECT
 
+  private:
+    ImagePlanes guide;                  // Guide for the cross-guided filter
+
+    bool guided(Image& image, bool enhance);
+
   public slots:
     bool Menu_Smoothing_3x3SmoothingFilter(Image& image);
+    bool Menu_Smoothing_GaussianSmoothing(Image& image);
+    bool Menu_Smoothing_BilateralFilter(Image& image);
+    bool Menu_Smoothing_GuidedFilter(Image& image);
+    bool Menu_Smoothing_GuidedDetailEnhance(Image& image);
+    bool Menu_Smoothing_SetGuideImage(Image& image);
 
 };
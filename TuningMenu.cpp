@@ -0,0 +1,122 @@
+/***************************************************************************//**
+ * TuningMenu.cpp
+ *
+ * Author - Dan Andrus
+ *
+ * Date - October 18, 2026
+ *
+ * Details - Defines the auto-tuner processes. The tuning itself is done in
+ * autotune.cpp.
+ *
+ ******************************************************************************/
+
+#include "TuningMenu.h"
+#include <QMessageBox>
+#include <climits>
+#include <cstring>
+
+/***************************************************************************//**
+ * profileText
+ * Author - Dan Andrus
+ *
+ * Describes the tuner's current crossovers and any forced variants.
+ ******************************************************************************/
+static string profileText()
+{
+  AutoTuner& tuner = autoTuner();
+  string text;
+  char line[160];
+
+  for (int c = 0; c < TUNED_CHOICES; c++)
+  {
+    long long cross = tuner.crossover((tunedChoice) c);
+    if (cross == LLONG_MAX)
+      sprintf(line, "%s: first variant always", tunedChoiceName((tunedChoice) c));
+    else
+      sprintf(line, "%s: second variant from %lld", tunedChoiceName((tunedChoice) c), cross);
+    if (tuner.forced((tunedChoice) c) >= 0)
+      sprintf(line + strlen(line), " (forced to variant %d)", tuner.forced((tunedChoice) c));
+    text += line;
+    text += "\n";
+  }
+
+  return text + "Profile: " + tuningProfilePath();
+}
+
+/***************************************************************************//**
+ * Menu_Tuning_Calibrate
+ * Author - Dan Andrus
+ *
+ * Times the filter variants on this machine, saves the crossovers to the
+ * profile and shows them. Takes a few seconds.
+ *
+ * Parameters -
+            image - the image object (unused).
+ *
+ * Returns
+ *          false, since the image is not changed
+ ******************************************************************************/
+bool TuningMenu::Menu_Tuning_Calibrate(Image& image)
+{
+  Q_UNUSED(image);
+
+  string text;
+
+  autoTuner().calibrate();
+  text = profileText();
+  if (!autoTuner().save(tuningProfilePath()))
+    text = "Could not save the profile\n" + text;
+
+  QMessageBox::information(0, "Calibration", text.c_str());
+  return false;
+}
+
+/***************************************************************************//**
+ * Menu_Tuning_ShowProfile
+ * Author - Dan Andrus
+ *
+ * Shows the crossovers in use: the median switches from sorting to a running
+ * histogram at the given mask width, and the band filters switch from one
+ * thread to all of them at the given number of pixels.
+ *
+ * Parameters -
+            image - the image object (unused).
+ *
+ * Returns
+ *          false, since the image is not changed
+ ******************************************************************************/
+bool TuningMenu::Menu_Tuning_ShowProfile(Image& image)
+{
+  Q_UNUSED(image);
+
+  QMessageBox::information(0, "Tuning Profile", profileText().c_str());
+  return false;
+}
+
+/***************************************************************************//**
+ * Menu_Tuning_ForceVariant
+ * Author - Dan Andrus
+ *
+ * Makes one choice always pick the same variant, for debugging, or puts it
+ * back under the profile's control. Not saved in the profile.
+ *
+ * Parameters -
+            image - the image object (unused).
+ *
+ * Returns
+ *          false, since the image is not changed
+ ******************************************************************************/
+bool TuningMenu::Menu_Tuning_ForceVariant(Image& image)
+{
+  Q_UNUSED(image);
+
+  int choice = TuneMedian;
+  int variant = -1;
+
+  if (Dialog("Force Variant")
+        .Add(choice, "Choice (0 Median, 1 Threads)", 0, TUNED_CHOICES - 1)
+        .Add(variant, "Variant (-1 Auto, 0 Sort/Serial, 1 Histogram/Threaded)", -1, 1).Show())
+    autoTuner().force((tunedChoice) choice, variant);
+
+  return false;
+}
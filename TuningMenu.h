@@ -0,0 +1,32 @@
+/***************************************************************************//**
+ * TuningMenu.h
+ *
+ * Author - Dan Andrus
+ *
+ * Date - October 18, 2026
+ *
+ * Details - Contains the declaration for the TuningMenu class
+ *
+ ******************************************************************************/
+
+#include "autotune.h"
+
+/***************************************************************************//**
+ * TuningMenu
+ *
+ * Author - Dan Andrus
+ *
+ * Child of QObject class.
+ *
+ * Declares processes that calibrate, show and override the auto-tuner's
+ * choice of filter implementations. None of them change the image.
+ ******************************************************************************/
+class TuningMenu : public QObject
+{
+  Q_OBJECT
+
+  public slots:
+    bool Menu_Tuning_Calibrate(Image& image);
+    bool Menu_Tuning_ShowProfile(Image& image);
+    bool Menu_Tuning_ForceVariant(Image& image);
+};
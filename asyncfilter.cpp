@@ -0,0 +1,360 @@
+/***************************************************************************//**
+ * asyncfilter.cpp
+ *
+ * Author - Dan Andrus
+ *
+ * Date - October 18, 2026
+ *
+ * Details - Background execution of the neighborhood filters. The GUI thread
+ * shows a progress dialog and keeps handling events while the filter runs,
+ * and the filtered pixels are only written into the image if the run was
+ * not cancelled.
+ *
+ ******************************************************************************/
+
+#include "asyncfilter.h"
+#include "resultcache.h"
+#include "autotune.h"
+#include "rankorder.h"
+#include <QProgressDialog>
+#include <QCoreApplication>
+#include <QThread>
+
+// Rows per band; the cancel flag is checked between bands
+static const int BAND_ROWS = 16;
+
+/***************************************************************************//**
+ * filterBand
+ * Author - Dan Andrus
+ *
+ * Runs the filter described by a task over one rectangle of an image.
+ *
+ * Parameters -
+ *          task - the filter to run
+ *          src - the unpacked image to filter
+ *          dst - receives the filtered rows; same size as src
+ *          area - the rectangle of src to filter
+ *
+ * Returns
+ *          True if the task names a known filter, false if not
+ ******************************************************************************/
+bool filterBand(const FilterTask& task, const ImagePlanes& src, ImagePlanes& dst,
+                const Rect& area)
+{
+  switch (task.kind)
+  {
+  case StatisticFilter:
+    // The histogram median gives the same result, faster for wide masks
+    if (task.op == Median &&
+        autoTuner().choose(TuneMedian, task.mask_w) == MedianHistogram)
+      medianBand(src, dst, area, task.mask_w);
+    else
+      statisticBand(src, dst, area, task.op, task.mask_w, task.threshold);
+    return true;
+
+  case StatisticGreyscaleFilter:
+    statisticGreyscaleBand(src, dst, area, task.op, task.mask_w);
+    return true;
+
+  case KirschFilter:
+    kirschBand(src, dst, area, task.mag);
+    return true;
+  }
+
+  return false;
+}
+
+/***************************************************************************//**
+ * AsyncFilter::AsyncFilter
+ * Author - Dan Andrus
+ *
+ * Creates an idle filter job.
+ ******************************************************************************/
+AsyncFilter::AsyncFilter()
+  : rows_done(0), cancelled(false), finished(false), rows(0)
+{
+}
+
+/***************************************************************************//**
+ * AsyncFilter::~AsyncFilter
+ * Author - Dan Andrus
+ *
+ * Stops and waits for any run still going, since it writes into this object.
+ ******************************************************************************/
+AsyncFilter::~AsyncFilter()
+{
+  if (worker.joinable())
+  {
+    cancel();
+    worker.join();
+  }
+}
+
+/***************************************************************************//**
+ * AsyncFilter::run
+ * Author - Dan Andrus
+ *
+ * Body of the worker thread. Bands are handed out to the OpenMP threads one
+ * at a time, each checking the cancel flag before it starts. Small jobs, where
+ * the tuner finds starting threads costs more than it saves, run serially.
+ *
+ * Parameters -
+ *          job - the filter job to carry out
+ ******************************************************************************/
+void AsyncFilter::run(AsyncFilter* job)
+{
+  int bands = (int)job->bands.size();
+  long long pixels = 0;                 // Pixels in all the bands
+  bool threaded;                        // Worth starting threads for
+
+  for (int b = 0; b < bands; b++)
+    pixels += (long long)job->bands[b].w * job->bands[b].h;
+  threaded = autoTuner().choose(TuneThreads, pixels) == RunThreaded;
+
+  #pragma omp parallel for schedule(dynamic) if (threaded)
+  for (int b = 0; b < bands; b++)
+  {
+    if (job->cancelled.load(std::memory_order_relaxed)) continue;
+
+    filterBand(job->task, job->source, job->output, job->bands[b]);
+    job->rows_done.fetch_add(job->bands[b].h, std::memory_order_relaxed);
+  }
+
+  job->finished.store(true);
+}
+
+/***************************************************************************//**
+ * AsyncFilter::start
+ * Author - Dan Andrus
+ *
+ * Starts filtering a copy of an image. Any earlier run is cancelled first.
+ * If the task names no areas the whole image is filtered.
+ *
+ * Parameters -
+ *          src - the unpacked image to filter; copied, so it may go away
+ *          t - the filter to run
+ ******************************************************************************/
+void AsyncFilter::start(const ImagePlanes& src, const FilterTask& t)
+{
+  if (worker.joinable())
+  {
+    cancel();
+    worker.join();
+  }
+
+  source = src;
+  output = src;
+  task = t;
+
+  if (task.areas.empty())
+    task.areas.push_back(makeRect(0, 0, src.width, src.height));
+
+  // Cut every area into bands of rows
+  bands.clear();
+  rows = 0;
+  for (size_t a = 0; a < task.areas.size(); a++)
+  {
+    const Rect& area = task.areas[a];
+    for (int y = 0; y < area.h; y += BAND_ROWS)
+      bands.push_back(makeRect(area.x, area.y + y, area.w, std::min(BAND_ROWS, area.h - y)));
+    rows += std::max(0, area.h);
+  }
+
+  rows_done.store(0);
+  cancelled.store(false);
+  finished.store(false);
+  worker = std::thread(run, this);
+}
+
+/***************************************************************************//**
+ * AsyncFilter::cancel
+ * Author - Dan Andrus
+ *
+ * Asks the run to stop. Bands already started are allowed to finish.
+ ******************************************************************************/
+void AsyncFilter::cancel()
+{
+  cancelled.store(true);
+}
+
+/***************************************************************************//**
+ * AsyncFilter::done
+ * Author - Dan Andrus
+ *
+ * Returns
+ *          True once the worker has stopped, whether finished or cancelled
+ ******************************************************************************/
+bool AsyncFilter::done() const
+{
+  return finished.load();
+}
+
+/***************************************************************************//**
+ * AsyncFilter::progress
+ * Author - Dan Andrus
+ *
+ * Returns
+ *          The number of rows filtered so far
+ ******************************************************************************/
+int AsyncFilter::progress() const
+{
+  return rows_done.load(std::memory_order_relaxed);
+}
+
+/***************************************************************************//**
+ * AsyncFilter::total
+ * Author - Dan Andrus
+ *
+ * Returns
+ *          The number of rows to filter
+ ******************************************************************************/
+int AsyncFilter::total() const
+{
+  return rows;
+}
+
+/***************************************************************************//**
+ * AsyncFilter::finish
+ * Author - Dan Andrus
+ *
+ * Waits for the worker and hands over the filtered image.
+ *
+ * Parameters -
+ *          result - receives the filtered image if the run completed
+ *
+ * Returns
+ *          True if every row was filtered, false if cancelled or never started
+ ******************************************************************************/
+bool AsyncFilter::finish(ImagePlanes& result)
+{
+  if (!worker.joinable()) return false;
+
+  worker.join();
+  if (cancelled.load() || rows_done.load() != rows)
+    return false;
+
+  result.width = output.width;
+  result.height = output.height;
+  result.red.swap(output.red);
+  result.green.swap(output.green);
+  result.blue.swap(output.blue);
+  result.intensity.swap(output.intensity);
+  result.gray = output.gray;
+  return true;
+}
+
+/***************************************************************************//**
+ * taskKey
+ * Author - Dan Andrus
+ *
+ * Describes a task and its areas for use in a result cache key.
+ *
+ * Parameters -
+ *          task - the filter to describe
+ *
+ * Returns
+ *          The task as text
+ ******************************************************************************/
+static string taskKey(const FilterTask& task)
+{
+  char text[96];
+  string key;
+
+  sprintf(text, "task %d op %d mask %d threshold %d mag %d",
+          (int)task.kind, (int)task.op, task.mask_w, task.threshold, (int)task.mag);
+  key = text;
+
+  for (size_t a = 0; a < task.areas.size(); a++)
+  {
+    sprintf(text, " [%d,%d %dx%d]", task.areas[a].x, task.areas[a].y,
+            task.areas[a].w, task.areas[a].h);
+    key += text;
+  }
+
+  return key;
+}
+
+/***************************************************************************//**
+ * runWithProgress
+ * Author - Dan Andrus
+ *
+ * Runs a filter in the background while showing a progress dialog with a
+ * cancel button. The GUI keeps processing events while it waits. If the user
+ * cancels, the image is left exactly as it was.
+ *
+ * Only the requested regions are filtered. Just their bounding box, grown by
+ * the reach of the mask, is unpacked, so a small region of a large image
+ * costs little more than the region itself. If the same filter has already
+ * been run on the same pixels, the cached output is used instead.
+ *
+ * Parameters -
+ *          image - the image object to manipulate.
+ *          task - the filter to run
+ *          title - label for the progress dialog
+ *          regions - rectangles to filter; the active regions if not given
+ *
+ * Returns
+ *          True if the filter ran to completion, false if not
+ ******************************************************************************/
+bool runWithProgress(Image& image, const FilterTask& task, const char* title,
+                     const vector<Rect>* regions)
+{
+  ImagePlanes src;                      // The image before filtering
+  ImagePlanes result;                   // The image after filtering
+  AsyncFilter job;                      // The background run
+  FilterTask local = task;              // The task, with areas relative to box
+  vector<Rect> rects;                   // Regions to filter
+  Rect box;                             // Part of the image that is read
+  int halo;                             // How far the mask reaches
+  string key;                           // Names the task for the cache
+  unsigned long long hash;              // Hash of the pixels read
+  size_t r;                             // Temporary variable
+
+  if (image.IsNull()) return false;
+
+  rects = imageRegions(image.Width(), image.Height(), regions);
+  if (rects.empty()) return false;
+
+  halo = task.kind == KirschFilter ? 1 : task.mask_w;
+  box = padRect(boundingRect(rects), halo, image.Width(), image.Height());
+
+  if (!unpackRegion(image, box, src)) return false;
+
+  local.areas.clear();
+  for (r = 0; r < rects.size(); r++)
+    local.areas.push_back(makeRect(rects[r].x - box.x, rects[r].y - box.y,
+                                   rects[r].w, rects[r].h));
+
+  // The output only depends on the pixels read and the task
+  key = taskKey(local);
+  hash = hashPlanes(src);
+  if (resultCache().lookup(key, hash, result))
+  {
+    packRegions(result, box.x, box.y, rects, image);
+    return true;
+  }
+
+  job.start(src, local);
+
+  // Only pops up if the filter takes longer than half a second
+  QProgressDialog dialog(title, "Cancel", 0, job.total());
+  dialog.setWindowModality(Qt::ApplicationModal);
+  dialog.setMinimumDuration(500);
+
+  while (!job.done())
+  {
+    dialog.setValue(job.progress());
+    QCoreApplication::processEvents(QEventLoop::AllEvents, 20);
+    if (dialog.wasCanceled())
+      job.cancel();
+    QThread::msleep(10);
+  }
+  dialog.setValue(job.total());
+
+  if (!job.finish(result))
+    return false;
+
+  resultCache().store(key, hash, result);
+  packRegions(result, box.x, box.y, rects, image);
+  return true;
+}
@@ -0,0 +1,79 @@
+/***************************************************************************//**
+ * asyncfilter.h
+ *
+ * Author - Dan Andrus
+ *
+ * Date - October 18, 2026
+ *
+ * Details - Contains the declarations for running the slow neighborhood
+ * filters on worker threads with progress reporting and cancellation.
+ *
+ ******************************************************************************/
+
+#pragma once
+#include "planes.h"
+#include <thread>
+#include <atomic>
+
+// Which band function a FilterTask runs
+enum filterKind { StatisticFilter, StatisticGreyscaleFilter, KirschFilter };
+
+/***************************************************************************//**
+ * FilterTask
+ *
+ * Author - Dan Andrus
+ *
+ * Everything needed to run one of the band-based filters, gathered up front
+ * so no dialogs have to be shown from a worker thread.
+ ******************************************************************************/
+struct FilterTask
+{
+  filterKind kind;                      // Which filter to run
+  operation op;                         // Operation for the statistic filters
+  int mask_w;                           // Mask width for the statistic filters
+  int threshold;                        // Threshold for NoiseClean
+  bool mag;                             // Magnitude or direction for Kirsch
+  vector<Rect> areas;                   // Rectangles of the source to filter
+};
+
+/***************************************************************************//**
+ * AsyncFilter
+ *
+ * Author - Dan Andrus
+ *
+ * Runs a FilterTask over a private copy of an image on a worker thread. Each
+ * area of the task is cut into bands of rows that are spread over all cores. Finished
+ * rows are added to a lock-free counter the GUI can poll, and the cancel flag
+ * is checked before each band is started. The result only becomes available
+ * once every band is done, so a cancelled run produces nothing.
+ ******************************************************************************/
+class AsyncFilter
+{
+  public:
+    AsyncFilter();
+    ~AsyncFilter();
+    void start(const ImagePlanes& src, const FilterTask& task);
+    void cancel();
+    bool done() const;
+    int progress() const;
+    int total() const;
+    bool finish(ImagePlanes& result);
+
+  private:
+    static void run(AsyncFilter* job);
+
+    std::thread worker;                 // Thread driving the bands
+    std::atomic<int> rows_done;         // Rows finished so far
+    std::atomic<bool> cancelled;        // Set to stop at the next band
+    std::atomic<bool> finished;         // Set once the worker has returned
+    FilterTask task;                    // The filter being run
+    vector<Rect> bands;                 // Areas cut into bands of rows
+    int rows;                           // Rows in all the bands together
+    ImagePlanes source;                 // Private copy of the input
+    ImagePlanes output;                 // Where the bands are written
+};
+
+bool filterBand(const FilterTask& task, const ImagePlanes& src, ImagePlanes& dst,
+                const Rect& area);
+bool runWithProgress(Image& image, const FilterTask& task, const char* title,
+                     const vector<Rect>* regions = 0);
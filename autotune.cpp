@@ -0,0 +1,340 @@
+/***************************************************************************//**
+ * autotune.cpp
+ *
+ * Author - Dan Andrus
+ *
+ * Date - October 18, 2026
+ *
+ * Details - Picks between implementations of a filter that give the same
+ * output at different speeds. Which is faster depends on the filter size,
+ * the image size and the machine, so each choice is reduced to a crossover
+ * size measured by a calibration run and kept in a profile file in the
+ * user's home directory. The profile is read the first time the tuner is
+ * used; until a calibration has been saved, built-in crossovers are used.
+ *
+ ******************************************************************************/
+
+#include "autotune.h"
+#include "rankorder.h"
+#include <cstdio>
+#include <cstdlib>
+#include <climits>
+
+// Crossovers used before any calibration
+static const long long DEFAULT_MEDIAN_CROSS = 5;
+static const long long DEFAULT_THREAD_CROSS = 128 * 128;
+
+// Never switch to the second variant
+static const long long NEVER = LLONG_MAX;
+
+/***************************************************************************//**
+ * AutoTuner::AutoTuner
+ * Author - Dan Andrus
+ *
+ * Starts with the built-in crossovers and nothing forced.
+ ******************************************************************************/
+AutoTuner::AutoTuner()
+{
+  reset();
+  for (int c = 0; c < TUNED_CHOICES; c++)
+    forced_variant[c] = -1;
+}
+
+/***************************************************************************//**
+ * AutoTuner::AutoTuner
+ * Author - Dan Andrus
+ *
+ * Starts with the built-in crossovers and nothing forced, then reads the
+ * crossovers saved in a profile, if there is one.
+ *
+ * Parameters -
+ *          path - the profile to read
+ ******************************************************************************/
+AutoTuner::AutoTuner(const string& path) : AutoTuner()
+{
+  load(path);
+}
+
+/***************************************************************************//**
+ * AutoTuner::reset
+ * Author - Dan Andrus
+ *
+ * Goes back to the built-in crossovers.
+ ******************************************************************************/
+void AutoTuner::reset()
+{
+  cross[TuneMedian] = DEFAULT_MEDIAN_CROSS;
+  cross[TuneThreads] = DEFAULT_THREAD_CROSS;
+}
+
+/***************************************************************************//**
+ * AutoTuner::choose
+ * Author - Dan Andrus
+ *
+ * Parameters -
+ *          choice - the decision to make
+ *          size - the mask width or pixel count the decision depends on
+ *
+ * Returns
+ *          The variant to run: the forced one if any, otherwise 0 below the
+ *          crossover and 1 at or above it
+ ******************************************************************************/
+int AutoTuner::choose(tunedChoice choice, long long size) const
+{
+  int variant = forced_variant[choice]; // Read once; force() may run meanwhile
+
+  if (variant >= 0)
+    return variant;
+  return size >= cross[choice] ? 1 : 0;
+}
+
+/***************************************************************************//**
+ * AutoTuner::force
+ * Author - Dan Andrus
+ *
+ * Makes a choice always pick one variant, or -1 to go back to the profile.
+ ******************************************************************************/
+void AutoTuner::force(tunedChoice choice, int variant)
+{
+  forced_variant[choice] = variant < 0 ? -1 : std::min(variant, 1);
+}
+
+/***************************************************************************//**
+ * AutoTuner::forced
+ * Author - Dan Andrus
+ *
+ * Returns
+ *          The forced variant of a choice, or -1 if none
+ ******************************************************************************/
+int AutoTuner::forced(tunedChoice choice) const
+{
+  return forced_variant[choice];
+}
+
+/***************************************************************************//**
+ * AutoTuner::crossover
+ * Author - Dan Andrus
+ *
+ * Returns
+ *          The size at which a choice switches to its second variant
+ ******************************************************************************/
+long long AutoTuner::crossover(tunedChoice choice) const
+{
+  return cross[choice];
+}
+
+/***************************************************************************//**
+ * randomPlanes
+ * Author - Dan Andrus
+ *
+ * A w x h color image of random values, for timing.
+ ******************************************************************************/
+static void randomPlanes(ImagePlanes& planes, int w, int h)
+{
+  unsigned int state = 12345;
+  int n = w * h;
+
+  planes.width = w;
+  planes.height = h;
+  planes.red.resize(n);
+  planes.green.resize(n);
+  planes.blue.resize(n);
+  planes.intensity.resize(n);
+  for (int k = 0; k < n; k++)
+  {
+    state = state * 1664525u + 1013904223u;
+    planes.red[k] = state >> 24;
+    planes.green[k] = state >> 16;
+    planes.blue[k] = state >> 8;
+    planes.intensity[k] = (planes.red[k] + planes.green[k] + planes.blue[k]) / 3;
+  }
+  planes.gray = false;
+}
+
+/***************************************************************************//**
+ * timeMedian
+ * Author - Dan Andrus
+ *
+ * Returns
+ *          Seconds taken by one variant of the band median over an image
+ ******************************************************************************/
+static double timeMedian(const ImagePlanes& src, ImagePlanes& dst, int mask_w, int variant)
+{
+  Rect area = makeRect(0, 0, src.width, src.height);
+  double start = omp_get_wtime();
+
+  if (variant == MedianHistogram)
+    medianBand(src, dst, area, mask_w);
+  else
+    statisticBand(src, dst, area, Median, mask_w, 0);
+
+  return omp_get_wtime() - start;
+}
+
+/***************************************************************************//**
+ * timeBands
+ * Author - Dan Andrus
+ *
+ * Returns
+ *          Seconds taken to run a 3x3 mean over an image in bands of 16 rows,
+ *          with or without threads
+ ******************************************************************************/
+static double timeBands(const ImagePlanes& src, ImagePlanes& dst, int variant)
+{
+  int bands = (src.height + 15) / 16;
+  double start = omp_get_wtime();
+
+  #pragma omp parallel for schedule(dynamic) if (variant == RunThreaded)
+  for (int b = 0; b < bands; b++)
+    statisticBand(src, dst, makeRect(0, b * 16, src.width, std::min(16, src.height - b * 16)),
+                  Mean, 3, 0);
+
+  return omp_get_wtime() - start;
+}
+
+/***************************************************************************//**
+ * AutoTuner::calibrate
+ * Author - Dan Andrus
+ *
+ * Times every variant over a range of sizes and sets each crossover to the
+ * smallest size from which the second variant is faster at every larger size
+ * tried. Each timing is the best of three runs. Takes a few seconds. The
+ * crossovers are only stored once measured, so filters running meanwhile
+ * keep using the old ones.
+ ******************************************************************************/
+void AutoTuner::calibrate()
+{
+  const int widths[] = { 3, 5, 7, 9, 11, 15 };
+  const int sides[] = { 32, 64, 128, 256, 512 };
+  ImagePlanes src, dst;
+  long long median_cross = NEVER;       // Measured median crossover
+  long long thread_cross = NEVER;       // Measured thread crossover
+  int k, run;
+
+  // Median: sort against histogram, by mask width, on a small image
+  randomPlanes(src, 128, 128);
+  dst = src;
+  for (k = (int) (sizeof(widths) / sizeof(widths[0])) - 1; k >= 0; k--)
+  {
+    double best[2] = { 1e30, 1e30 };
+    for (run = 0; run < 3; run++)
+      for (int v = 0; v < 2; v++)
+        best[v] = std::min(best[v], timeMedian(src, dst, widths[k], v));
+    if (best[MedianHistogram] >= best[MedianSort]) break;
+    median_cross = widths[k];
+  }
+
+  // Threads: serial against threaded, by image size
+  for (k = (int) (sizeof(sides) / sizeof(sides[0])) - 1; k >= 0; k--)
+  {
+    double best[2] = { 1e30, 1e30 };
+    randomPlanes(src, sides[k], sides[k]);
+    dst = src;
+    for (run = 0; run < 3; run++)
+      for (int v = 0; v < 2; v++)
+        best[v] = std::min(best[v], timeBands(src, dst, v));
+    if (best[RunThreaded] >= best[RunSerial]) break;
+    thread_cross = (long long) sides[k] * sides[k];
+  }
+
+  cross[TuneMedian] = median_cross;
+  cross[TuneThreads] = thread_cross;
+}
+
+/***************************************************************************//**
+ * AutoTuner::load
+ * Author - Dan Andrus
+ *
+ * Reads crossovers from a profile, one "name size" line per choice. Choices
+ * missing from the file keep their current crossovers.
+ *
+ * Returns
+ *          True if the file could be read, false if not
+ ******************************************************************************/
+bool AutoTuner::load(const string& path)
+{
+  FILE* file = fopen(path.c_str(), "r");
+  char name[64];
+  long long size;
+
+  if (!file) return false;
+
+  while (fscanf(file, "%63s %lld", name, &size) == 2)
+    for (int c = 0; c < TUNED_CHOICES; c++)
+      if (string(name) == tunedChoiceName((tunedChoice) c))
+        cross[c] = std::max(0LL, size);
+
+  fclose(file);
+  return true;
+}
+
+/***************************************************************************//**
+ * AutoTuner::save
+ * Author - Dan Andrus
+ *
+ * Writes the crossovers to a profile.
+ *
+ * Returns
+ *          True if the file was written, false if not
+ ******************************************************************************/
+bool AutoTuner::save(const string& path) const
+{
+  FILE* file = fopen(path.c_str(), "w");
+  bool ok;
+
+  if (!file) return false;
+
+  for (int c = 0; c < TUNED_CHOICES; c++)
+    fprintf(file, "%s %lld\n", tunedChoiceName((tunedChoice) c), cross[c].load());
+
+  ok = !ferror(file);
+  fclose(file);
+  return ok;
+}
+
+/***************************************************************************//**
+ * autoTuner
+ * Author - Dan Andrus
+ *
+ * Returns
+ *          The tuner shared by all the filters. It is made, and the profile
+ *          read, the first time it is asked for, from whichever thread asks.
+ ******************************************************************************/
+AutoTuner& autoTuner()
+{
+  static AutoTuner tuner(tuningProfilePath());
+  return tuner;
+}
+
+/***************************************************************************//**
+ * tuningProfilePath
+ * Author - Dan Andrus
+ *
+ * Returns
+ *          Where the profile is kept: prog2_tuning.txt in the home directory,
+ *          or the working directory if there is no home directory
+ ******************************************************************************/
+string tuningProfilePath()
+{
+  const char* home = getenv("HOME");
+
+  if (!home) home = getenv("USERPROFILE");
+  return string(home ? home : ".") + "/prog2_tuning.txt";
+}
+
+/***************************************************************************//**
+ * tunedChoiceName
+ * Author - Dan Andrus
+ *
+ * Returns
+ *          The name a choice is saved under
+ ******************************************************************************/
+const char* tunedChoiceName(tunedChoice choice)
+{
+  switch (choice)
+  {
+  case TuneMedian:  return "median";
+  case TuneThreads: return "threads";
+  default:          return "unknown";
+  }
+}
@@ -0,0 +1,65 @@
+/***************************************************************************//**
+ * autotune.h
+ *
+ * Author - Dan Andrus
+ *
+ * Date - October 18, 2026
+ *
+ * Details - Contains the declarations for the auto-tuner that picks between
+ * implementations of the same filter.
+ *
+ ******************************************************************************/
+
+#pragma once
+#include "planes.h"
+#include <atomic>
+#include <string>
+
+// Decisions the tuner makes
+enum tunedChoice
+{
+  TuneMedian,                           // How the band median is computed
+  TuneThreads,                          // Whether band filters use threads
+  TUNED_CHOICES
+};
+
+// Implementations of the band median
+enum medianVariant { MedianSort, MedianHistogram };
+
+// Ways to run the band filters
+enum threadVariant { RunSerial, RunThreaded };
+
+/***************************************************************************//**
+ * AutoTuner
+ *
+ * Author - Dan Andrus
+ *
+ * For each choice, the size at which the second implementation starts to beat
+ * the first: the mask width for the median, the number of pixels for
+ * threading. calibrate() measures them on this machine, and they are saved to
+ * and loaded from a small profile file. A variant can be forced for
+ * debugging, overriding the profile. The GUI thread calibrates and forces
+ * while filters on worker threads choose, so each entry is atomic.
+ ******************************************************************************/
+class AutoTuner
+{
+  public:
+    AutoTuner();
+    explicit AutoTuner(const string& path);
+    int choose(tunedChoice choice, long long size) const;
+    void force(tunedChoice choice, int variant);
+    int forced(tunedChoice choice) const;
+    long long crossover(tunedChoice choice) const;
+    void calibrate();
+    bool load(const string& path);
+    bool save(const string& path) const;
+    void reset();
+
+  private:
+    std::atomic<long long> cross[TUNED_CHOICES]; // Size where the second variant wins
+    std::atomic<int> forced_variant[TUNED_CHOICES]; // Variant to use regardless, or -1
+};
+
+AutoTuner& autoTuner();
+string tuningProfilePath();
+const char* tunedChoiceName(tunedChoice choice);
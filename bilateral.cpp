@@ -0,0 +1,379 @@
+/***************************************************************************//**
+ * bilateral.cpp
+ *
+ * Author - Dan Andrus
+ *
+ * Date - October 18, 2026
+ *
+ * Details - The bilateral filter, computed on a bilateral grid (Chen, Paris
+ * and Durand). Each pixel is added to the nearest cell of a coarse 3D grid
+ * over x, y and gray level, with cells sigma_s pixels wide and sigma_r levels
+ * deep. The grid is blurred with a five-tap binomial along each axis, which
+ * is a Gaussian of one cell, and each output pixel is read back from it by
+ * trilinear interpolation. The grid shrinks as sigma_s grows, so the cost is
+ * one splat and one slice per pixel plus a blur that gets cheaper, rather
+ * than a window of exponentials per pixel. Small sigmas on large images would
+ * need a grid of many gigabytes, so a grid over the memory budget is built a
+ * band of grid rows at a time, or the window is used directly when it is
+ * small enough to be cheaper.
+ *
+ ******************************************************************************/
+
+#include "bilateral.h"
+#include <climits>
+
+// Empty cells around the data, so the blur never reaches past the grid
+static const int GRID_PAD = 2;
+
+// Most bytes of grid held at once
+static const size_t GRID_BUDGET = (size_t) 256 << 20;
+
+// Rough cost of blurring one grid cell, in window taps of the direct filter
+static const double CELL_COST = 8.0;
+
+/***************************************************************************//**
+ * GridAxis
+ *
+ * Author - Dan Andrus
+ *
+ * Lookup table from a pixel coordinate or gray level to grid cells: the
+ * nearest cell for splatting, and the lower cell and weight of the upper one
+ * for slicing.
+ ******************************************************************************/
+struct GridAxis
+{
+  vector<int> nearest;                  // Cell to splat into
+  vector<int> lower;                    // Lower cell to slice from
+  vector<float> frac;                   // Weight of the cell above lower
+  int cells;                            // Cells along the axis, with padding
+
+  void build(int n, double spacing)
+  {
+    nearest.resize(n);
+    lower.resize(n);
+    frac.resize(n);
+    for (int k = 0; k < n; k++)
+    {
+      double pos = k / spacing + GRID_PAD;
+      nearest[k] = (int) (pos + 0.5);
+      lower[k] = (int) pos;
+      frac[k] = (float) (pos - lower[k]);
+    }
+    cells = (int) ((n - 1) / spacing) + 2 * GRID_PAD + 2;
+  }
+};
+
+/***************************************************************************//**
+ * blurLine
+ * Author - Dan Andrus
+ *
+ * Blurs a line of (value, weight) cells with the [1 4 6 4 1] / 16 binomial.
+ * The ends are padding, so they are treated as zero.
+ *
+ * Parameters -
+ *          cell - first cell of the line
+ *          n - cells in the line
+ *          stride - floats from one cell to the next
+ *          tmp - scratch space for 2n floats
+ ******************************************************************************/
+static void blurLine(float* cell, int n, size_t stride, float* tmp)
+{
+  for (int k = 0; k < n; k++)
+  {
+    tmp[2 * k] = cell[k * stride];
+    tmp[2 * k + 1] = cell[k * stride + 1];
+  }
+
+  for (int k = 0; k < n; k++)
+  {
+    for (int c = 0; c < 2; c++)
+    {
+      float sum = 6 * tmp[2 * k + c];
+      if (k >= 1)     sum += 4 * tmp[2 * (k - 1) + c];
+      if (k >= 2)     sum += tmp[2 * (k - 2) + c];
+      if (k + 1 < n)  sum += 4 * tmp[2 * (k + 1) + c];
+      if (k + 2 < n)  sum += tmp[2 * (k + 2) + c];
+      cell[k * stride + c] = sum * (1.0f / 16);
+    }
+  }
+}
+
+/***************************************************************************//**
+ * bilateralDirect
+ * Author - Dan Andrus
+ *
+ * Applies the bilateral filter to one 8-bit plane by visiting every pixel of
+ * a window reaching two sigma_s around each pixel, the same reach as the grid
+ * blur. Pixels outside the plane are left out, as they are from the grid.
+ *
+ * Parameters -
+ *          plane - the row-major plane to filter
+ *          w - columns in the plane
+ *          h - rows in the plane
+ *          sigma_s - spatial standard deviation, in pixels
+ *          sigma_r - range standard deviation, in gray levels
+ ******************************************************************************/
+static void bilateralDirect(vector<uchar>& plane, int w, int h, double sigma_s, double sigma_r)
+{
+  int r = (int) ceil(2 * sigma_s);      // Reach of the window
+  int side = 2 * r + 1;                 // Width of the window
+  vector<float> spatial(side * side);   // Weight of each window offset
+  float range[256];                     // Weight of each difference in value
+  vector<uchar> src(plane);             // The plane before filtering
+
+  for (int dy = -r; dy <= r; dy++)
+    for (int dx = -r; dx <= r; dx++)
+      spatial[(dy + r) * side + dx + r] =
+        (float) exp(-(dx * dx + dy * dy) / (2 * sigma_s * sigma_s));
+  for (int d = 0; d < 256; d++)
+    range[d] = (float) exp(-(d * d) / (2 * sigma_r * sigma_r));
+
+  #pragma omp parallel for schedule(dynamic)
+  for (int y = 0; y < h; y++)
+  {
+    int y0 = std::max(0, y - r), y1 = std::min(h - 1, y + r);
+
+    for (int x = 0; x < w; x++)
+    {
+      int x0 = std::max(0, x - r), x1 = std::min(w - 1, x + r);
+      int center = src[(size_t) y * w + x];
+      float value = 0, weight = 0;
+
+      for (int i = y0; i <= y1; i++)
+      {
+        const uchar* row = &src[(size_t) i * w];
+        const float* ws = &spatial[(i - y + r) * side + r - x];
+        for (int j = x0; j <= x1; j++)
+        {
+          float wk = ws[j] * range[std::abs(row[j] - center)];
+          value += wk * row[j];
+          weight += wk;
+        }
+      }
+
+      plane[(size_t) y * w + x] = (uchar) std::max(0, std::min(255, (int) (value / weight + 0.5f)));
+    }
+  }
+}
+
+/***************************************************************************//**
+ * gridBand
+ * Author - Dan Andrus
+ *
+ * Splats, blurs and slices the grid rows g0 to g1 - 1. The blur reaches two
+ * cells and the slice one cell further, so rows g0 - 2 to g1 + 2 are built;
+ * rows past the edges of the grid stay empty, as they would in a whole grid.
+ *
+ * Parameters -
+ *          src - the plane to splat from
+ *          dst - receives the pixels whose lower grid row lies in the band
+ *          w - columns in the plane
+ *          h - rows in the plane
+ *          ax, ay, az - the grid axes
+ *          g0 - first grid row to slice from
+ *          g1 - one past the last grid row to slice from
+ *          grid - scratch space for the band
+ ******************************************************************************/
+static void gridBand(const uchar* src, uchar* dst, int w, int h, const GridAxis& ax,
+                     const GridAxis& ay, const GridAxis& az, int g0, int g1,
+                     vector<float>& grid)
+{
+  int b0 = std::max(0, g0 - 2);         // First grid row built
+  int b1 = std::min(ay.cells, g1 + 3);  // One past the last grid row built
+  int rows = b1 - b0;                   // Grid rows built
+  size_t sz, sx, sy;                    // Floats from cell to cell in z, x, y
+  int s0, s1;                           // Pixel rows sliced
+
+  sz = 2;
+  sx = sz * az.cells;
+  sy = sx * ax.cells;
+  grid.assign(sy * rows, 0.0f);
+
+  // Splat: each grid row gathers its own pixel rows, so threads never share
+  // a cell. Pixel rows map to grid rows in order.
+  #pragma omp parallel for schedule(dynamic)
+  for (int gy = b0; gy < b1; gy++)
+  {
+    int y0 = std::lower_bound(ay.nearest.begin(), ay.nearest.end(), gy) - ay.nearest.begin();
+    for (int y = y0; y < h && ay.nearest[y] == gy; y++)
+    {
+      const uchar* row = src + (size_t) y * w;
+      for (int x = 0; x < w; x++)
+      {
+        float* cell = &grid[(gy - b0) * sy + ax.nearest[x] * sx + az.nearest[row[x]] * sz];
+        cell[0] += row[x];
+        cell[1] += 1.0f;
+      }
+    }
+  }
+
+  // Blur along each axis in turn
+  #pragma omp parallel
+  {
+    vector<float> tmp(2 * std::max(az.cells, std::max(ax.cells, rows)));
+
+    #pragma omp for
+    for (int gy = 0; gy < rows; gy++)
+      for (int gx = 0; gx < ax.cells; gx++)
+        blurLine(&grid[gy * sy + gx * sx], az.cells, sz, &tmp[0]);
+
+    #pragma omp for
+    for (int gy = 0; gy < rows; gy++)
+      for (int gz = 0; gz < az.cells; gz++)
+        blurLine(&grid[gy * sy + gz * sz], ax.cells, sx, &tmp[0]);
+
+    #pragma omp for
+    for (int gx = 0; gx < ax.cells; gx++)
+      for (int gz = 0; gz < az.cells; gz++)
+        blurLine(&grid[gx * sx + gz * sz], rows, sy, &tmp[0]);
+  }
+
+  // Slice: interpolate each pixel's value back out of the grid
+  s0 = std::lower_bound(ay.lower.begin(), ay.lower.end(), g0) - ay.lower.begin();
+  s1 = std::lower_bound(ay.lower.begin(), ay.lower.end(), g1) - ay.lower.begin();
+
+  #pragma omp parallel for
+  for (int y = s0; y < s1; y++)
+  {
+    const uchar* in = src + (size_t) y * w;
+    uchar* out = dst + (size_t) y * w;
+    float fy = ay.frac[y];
+    const float* base = &grid[(ay.lower[y] - b0) * sy];
+
+    for (int x = 0; x < w; x++)
+    {
+      int level = in[x];
+      float fx = ax.frac[x], fz = az.frac[level];
+      const float* c = base + ax.lower[x] * sx + az.lower[level] * sz;
+      float value = 0, weight = 0;
+
+      for (int k = 0; k < 8; k++)
+      {
+        const float* cell = c + ((k & 4) ? sy : 0) + ((k & 2) ? sx : 0) + ((k & 1) ? sz : 0);
+        float wk = ((k & 4) ? fy : 1 - fy) * ((k & 2) ? fx : 1 - fx) * ((k & 1) ? fz : 1 - fz);
+        value += wk * cell[0];
+        weight += wk * cell[1];
+      }
+
+      if (weight > 0)
+        out[x] = (uchar) std::max(0, std::min(255, (int) (value / weight + 0.5f)));
+    }
+  }
+}
+
+/***************************************************************************//**
+ * bilateralPlane
+ * Author - Dan Andrus
+ *
+ * Applies the bilateral filter to one 8-bit plane. A grid that fits in
+ * GRID_BUDGET is built whole. A bigger one is built in bands of grid rows
+ * that each fit, unless the direct window would cost less.
+ *
+ * Parameters -
+ *          plane - the row-major plane to filter
+ *          w - columns in the plane
+ *          h - rows in the plane
+ *          sigma_s - spatial standard deviation, in pixels
+ *          sigma_r - range standard deviation, in gray levels
+ ******************************************************************************/
+void bilateralPlane(vector<uchar>& plane, int w, int h, double sigma_s, double sigma_r)
+{
+  GridAxis ax, ay, az;                  // Columns, rows and levels
+  vector<float> grid;                   // (value, weight) cells, z fastest
+  size_t row_bytes;                     // Bytes in one grid row
+  int band;                             // Grid rows sliced per band
+  double grid_cost, direct_cost;        // Work of the two methods, in taps
+
+  ax.build(w, sigma_s);
+  ay.build(h, sigma_s);
+  az.build(256, sigma_r);
+
+  row_bytes = 2 * sizeof(float) * (size_t) az.cells * ax.cells;
+  band = std::max(1, (int) std::min((size_t) INT_MAX, GRID_BUDGET / row_bytes) - 5);
+
+  // The whole grid fits
+  if (band >= ay.cells)
+  {
+    gridBand(&plane[0], &plane[0], w, h, ax, ay, az, 0, ay.cells, grid);
+    return;
+  }
+
+  // Each band also builds the five rows around it
+  grid_cost = CELL_COST * ay.cells * (1.0 + 5.0 / band) * az.cells * ax.cells;
+  direct_cost = (double) w * h * (2 * ceil(2 * sigma_s) + 1) * (2 * ceil(2 * sigma_s) + 1);
+  if (direct_cost < grid_cost)
+  {
+    bilateralDirect(plane, w, h, sigma_s, sigma_r);
+    return;
+  }
+
+  // Later bands splat rows earlier bands have already sliced
+  vector<uchar> src(plane);
+  grid.reserve(row_bytes / sizeof(float) * (band + 5));
+  for (int g0 = 0; g0 < ay.cells; g0 += band)
+    gridBand(&src[0], &plane[0], w, h, ax, ay, az, g0, std::min(ay.cells, g0 + band), grid);
+}
+
+/***************************************************************************//**
+ * bilateralPlanes
+ * Author - Dan Andrus
+ *
+ * Applies the bilateral filter to the red, green and blue planes of an
+ * unpacked image, each with its own grid. Grey images are filtered once.
+ *
+ * Parameters -
+ *          planes - the unpacked image to manipulate
+ *          sigma_s - spatial standard deviation, in pixels
+ *          sigma_r - range standard deviation, in gray levels
+ *
+ * Returns
+ *          True if the operation was successful, false if not
+ ******************************************************************************/
+bool bilateralPlanes(ImagePlanes& planes, double sigma_s, double sigma_r)
+{
+  if (planes.width == 0 || planes.height == 0 || sigma_s <= 0 || sigma_r <= 0)
+    return false;
+
+  bilateralPlane(planes.red, planes.width, planes.height, sigma_s, sigma_r);
+  if (planes.gray)
+  {
+    planes.green = planes.red;
+    planes.blue = planes.red;
+  }
+  else
+  {
+    bilateralPlane(planes.green, planes.width, planes.height, sigma_s, sigma_r);
+    bilateralPlane(planes.blue, planes.width, planes.height, sigma_s, sigma_r);
+  }
+
+  return true;
+}
+
+/***************************************************************************//**
+ * bilateralImage
+ * Author - Dan Andrus
+ *
+ * Applies the bilateral filter to the active regions of an image.
+ *
+ * Parameters -
+ *          image - the image object to manipulate
+ *          sigma_s - spatial standard deviation, in pixels
+ *          sigma_r - range standard deviation, in gray levels
+ *
+ * Returns
+ *          True if the operation was successful, false if not
+ ******************************************************************************/
+bool bilateralImage(Image& image, double sigma_s, double sigma_r)
+{
+  ImagePlanes planes;
+
+  if (image.IsNull()) return false;
+
+  unpackImage(image, planes);
+  if (!bilateralPlanes(planes, sigma_s, sigma_r))
+    return false;
+
+  packRegions(planes, 0, 0, imageRegions(planes.width, planes.height), image);
+
+  return true;
+}
@@ -0,0 +1,18 @@
+/***************************************************************************//**
+ * bilateral.h
+ *
+ * Author - Dan Andrus
+ *
+ * Date - October 18, 2026
+ *
+ * Details - Contains the declarations for the bilateral filter on a
+ * bilateral grid.
+ *
+ ******************************************************************************/
+
+#pragma once
+#include "planes.h"
+
+void bilateralPlane(vector<uchar>& plane, int w, int h, double sigma_s, double sigma_r);
+bool bilateralPlanes(ImagePlanes& planes, double sigma_s, double sigma_r);
+bool bilateralImage(Image& image, double sigma_s, double sigma_r);
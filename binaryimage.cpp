@@ -0,0 +1,531 @@
+/***************************************************************************//**
+ * binaryimage.cpp
+ *
+ * Author - Dan Andrus
+ *
+ * Date - October 18, 2026
+ *
+ * Details - Bit-packed black and white images. A thresholded image takes
+ * one bit per pixel instead of 32, and erosion, dilation and the majority
+ * (binary median) filter handle 64 pixels per word operation. Erosion and
+ * dilation ignore pixels outside the image, which for these rectangular
+ * windows gives the same result as the nearest-pixel borders of the rank
+ * order filters; the majority filter repeats the edge pixels, as the median
+ * filter does.
+ *
+ ******************************************************************************/
+
+#include "binaryimage.h"
+
+// Bits per word
+static const int WORD_BITS = 64;
+
+/***************************************************************************//**
+ * shiftedWord
+ * Author - Dan Andrus
+ *
+ * The 64 pixels starting s pixels to the right of word w of an extended row,
+ * i.e. the row moved left by s pixels.
+ *
+ * Parameters -
+ *          ext - the row with guard words on both sides
+ *          w - index of the word in ext
+ *          s - pixels to move by, positive or negative
+ *
+ * Returns
+ *          The moved word
+ ******************************************************************************/
+static inline unsigned long long shiftedWord(const unsigned long long* ext, int w, int s)
+{
+  int word = w + (s >= 0 ? s / WORD_BITS : -((-s + WORD_BITS - 1) / WORD_BITS));
+  int bit = s - (word - w) * WORD_BITS;  // 0 to 63
+
+  if (bit == 0) return ext[word];
+  return (ext[word] >> bit) | (ext[word + 1] << (WORD_BITS - bit));
+}
+
+/***************************************************************************//**
+ * windowReach
+ * Author - Dan Andrus
+ *
+ * Splits a window size into the pixels before and after its center, placing
+ * the center as the toolbox masks do.
+ *
+ * Parameters -
+ *          size - the window size
+ *          before - receives the pixels left of or above the center
+ *          after - receives the pixels right of or below the center
+ ******************************************************************************/
+static void windowReach(int size, int& before, int& after)
+{
+  before = std::max(0, size / 2 - (1 - size % 2));
+  after = std::max(0, size - 1 - before);
+}
+
+/***************************************************************************//**
+ * BinaryImage::BinaryImage
+ * Author - Dan Andrus
+ *
+ * Creates an empty image.
+ ******************************************************************************/
+BinaryImage::BinaryImage() : w(0), h(0), stride(0)
+{
+}
+
+/***************************************************************************//**
+ * BinaryImage::resize
+ * Author - Dan Andrus
+ *
+ * Makes the image w x h, all black.
+ ******************************************************************************/
+void BinaryImage::resize(int width, int height)
+{
+  w = width;
+  h = height;
+  stride = (w + WORD_BITS - 1) / WORD_BITS;
+  bits.assign((size_t)stride * h, 0);
+}
+
+/***************************************************************************//**
+ * BinaryImage::lastMask
+ * Author - Dan Andrus
+ *
+ * Returns
+ *          The bits of the last word of a row that lie inside the image
+ ******************************************************************************/
+unsigned long long BinaryImage::lastMask() const
+{
+  int used = w - (stride - 1) * WORD_BITS;
+  return used == WORD_BITS ? ~0ULL : (1ULL << used) - 1;
+}
+
+/***************************************************************************//**
+ * BinaryImage::fromPlanes
+ * Author - Dan Andrus
+ *
+ * Thresholds an unpacked image: pixels whose intensity is at least the
+ * threshold become white, as with the binary threshold point process.
+ *
+ * Parameters -
+ *          planes - the unpacked image
+ *          threshold - the lowest white intensity
+ *
+ * Returns
+ *          True if the operation was successful, false if not
+ ******************************************************************************/
+bool BinaryImage::fromPlanes(const ImagePlanes& planes, int threshold)
+{
+  if (planes.width == 0 || planes.height == 0) return false;
+
+  resize(planes.width, planes.height);
+
+  #pragma omp parallel for
+  for (int y = 0; y < h; y++)
+  {
+    const uchar* row = &planes.intensity[(size_t)y * w];
+    unsigned long long* out = &bits[(size_t)y * stride];
+
+    for (int x = 0; x < w; x++)
+      if (row[x] >= threshold)
+        out[x / WORD_BITS] |= 1ULL << (x % WORD_BITS);
+  }
+
+  return true;
+}
+
+/***************************************************************************//**
+ * BinaryImage::fromImage
+ * Author - Dan Andrus
+ *
+ * Thresholds an image (see fromPlanes). An image already thresholded to
+ * black and white converts exactly with any threshold from 1 to 255.
+ ******************************************************************************/
+bool BinaryImage::fromImage(Image& image, int threshold)
+{
+  ImagePlanes planes;
+
+  return unpackImage(image, planes) && fromPlanes(planes, threshold);
+}
+
+/***************************************************************************//**
+ * BinaryImage::toPlanes
+ * Author - Dan Andrus
+ *
+ * Expands the image to 8-bit planes of black (0) and white (255).
+ ******************************************************************************/
+void BinaryImage::toPlanes(ImagePlanes& planes) const
+{
+  int n = w * h;
+
+  planes.width = w;
+  planes.height = h;
+  planes.red.resize(n);
+
+  #pragma omp parallel for
+  for (int y = 0; y < h; y++)
+    for (int x = 0; x < w; x++)
+      planes.red[(size_t)y * w + x] = get(x, y) ? 255 : 0;
+
+  planes.green = planes.red;
+  planes.blue = planes.red;
+  planes.intensity = planes.red;
+  planes.gray = true;
+}
+
+/***************************************************************************//**
+ * BinaryImage::toImage
+ * Author - Dan Andrus
+ *
+ * Writes the image into a QtImageLib image of the same size as black and
+ * white. Only the active regions are written.
+ ******************************************************************************/
+void BinaryImage::toImage(Image& image) const
+{
+  ImagePlanes planes;
+
+  toPlanes(planes);
+  packRegions(planes, 0, 0, imageRegions(w, h), image);
+}
+
+/***************************************************************************//**
+ * BinaryImage::get
+ * Author - Dan Andrus
+ *
+ * Returns
+ *          True if pixel (x, y) is white
+ ******************************************************************************/
+bool BinaryImage::get(int x, int y) const
+{
+  return (bits[(size_t)y * stride + x / WORD_BITS] >> (x % WORD_BITS)) & 1;
+}
+
+/***************************************************************************//**
+ * BinaryImage::set
+ * Author - Dan Andrus
+ *
+ * Makes pixel (x, y) white if value is true, black if not.
+ ******************************************************************************/
+void BinaryImage::set(int x, int y, bool value)
+{
+  unsigned long long& word = bits[(size_t)y * stride + x / WORD_BITS];
+  unsigned long long bit = 1ULL << (x % WORD_BITS);
+
+  if (value)
+    word |= bit;
+  else
+    word &= ~bit;
+}
+
+/***************************************************************************//**
+ * BinaryImage::count
+ * Author - Dan Andrus
+ *
+ * Returns
+ *          The number of white pixels
+ ******************************************************************************/
+long long BinaryImage::count() const
+{
+  long long total = 0;
+
+  #pragma omp parallel for reduction(+:total)
+  for (long long k = 0; k < (long long)bits.size(); k++)
+    total += __builtin_popcountll(bits[k]);
+
+  return total;
+}
+
+/***************************************************************************//**
+ * BinaryImage::extendRow
+ * Author - Dan Andrus
+ *
+ * Copies a row with guard words on both sides, so shifted reads never leave
+ * the buffer. With fill 0 or 1 the outside is black or white; with fill -1
+ * it repeats the edge pixels.
+ *
+ * Parameters -
+ *          y - the row
+ *          guard - guard words on each side
+ *          fill - 0, 1 or -1 as above
+ *          ext - receives the extended row
+ ******************************************************************************/
+void BinaryImage::extendRow(int y, int guard, int fill, vector<unsigned long long>& ext) const
+{
+  const unsigned long long* row = &bits[(size_t)y * stride];
+  unsigned long long left, right;       // Fill words on each side
+  unsigned long long mask = lastMask();
+
+  if (fill < 0)
+  {
+    left = (row[0] & 1) ? ~0ULL : 0;
+    right = get(w - 1, y) ? ~0ULL : 0;
+  }
+  else
+    left = right = fill ? ~0ULL : 0;
+
+  ext.resize(stride + 2 * guard);
+  for (int k = 0; k < guard; k++)
+  {
+    ext[k] = left;
+    ext[guard + stride + k] = right;
+  }
+  for (int k = 0; k < stride; k++)
+    ext[guard + k] = row[k];
+  ext[guard + stride - 1] = (row[stride - 1] & mask) | (right & ~mask);
+}
+
+/***************************************************************************//**
+ * BinaryImage::rowPass
+ * Author - Dan Andrus
+ *
+ * Erodes or dilates every row by a line reaching left pixels to the left and
+ * right pixels to the right: each word is combined with the row shifted by
+ * -left to right pixels.
+ ******************************************************************************/
+void BinaryImage::rowPass(int left, int right, bool dilate)
+{
+  int guard = std::max(left, right) / WORD_BITS + 2;
+  unsigned long long mask = lastMask();
+
+  if (left <= 0 && right <= 0) return;
+
+  #pragma omp parallel
+  {
+    vector<unsigned long long> ext;
+
+    #pragma omp for
+    for (int y = 0; y < h; y++)
+    {
+      unsigned long long* row = &bits[(size_t)y * stride];
+
+      extendRow(y, guard, dilate ? 0 : 1, ext);
+      for (int k = 0; k < stride; k++)
+      {
+        unsigned long long v = ext[guard + k];
+        for (int s = -left; s <= right; s++)
+        {
+          if (dilate)
+            v |= shiftedWord(&ext[0], guard + k, s);
+          else
+            v &= shiftedWord(&ext[0], guard + k, s);
+        }
+        row[k] = v;
+      }
+      row[stride - 1] &= mask;
+    }
+  }
+}
+
+/***************************************************************************//**
+ * BinaryImage::columnPass
+ * Author - Dan Andrus
+ *
+ * Erodes or dilates every column by a line reaching above rows up and below
+ * rows down, combining whole rows of words. Rows outside the image are
+ * ignored.
+ ******************************************************************************/
+void BinaryImage::columnPass(int above, int below, bool dilate)
+{
+  if (above <= 0 && below <= 0) return;
+
+  vector<unsigned long long> src(bits);
+
+  #pragma omp parallel for
+  for (int y = 0; y < h; y++)
+  {
+    int top = std::max(0, y - above);
+    int bottom = std::min(h - 1, y + below);
+    unsigned long long* row = &bits[(size_t)y * stride];
+
+    for (int k = 0; k < stride; k++)
+    {
+      unsigned long long v = src[(size_t)top * stride + k];
+      for (int i = top + 1; i <= bottom; i++)
+      {
+        if (dilate)
+          v |= src[(size_t)i * stride + k];
+        else
+          v &= src[(size_t)i * stride + k];
+      }
+      row[k] = v;
+    }
+  }
+}
+
+/***************************************************************************//**
+ * BinaryImage::erode
+ * Author - Dan Andrus
+ *
+ * Erodes by a width x height rectangle: a pixel stays white only if every
+ * pixel under the rectangle is white.
+ ******************************************************************************/
+void BinaryImage::erode(int width, int height)
+{
+  int left, right, above, below;        // Reach of the rectangle
+
+  if (w == 0 || h == 0) return;
+  windowReach(width, left, right);
+  windowReach(height, above, below);
+  rowPass(left, right, false);
+  columnPass(above, below, false);
+}
+
+/***************************************************************************//**
+ * BinaryImage::dilate
+ * Author - Dan Andrus
+ *
+ * Dilates by a width x height rectangle: a pixel becomes white if any pixel
+ * under the rectangle is white.
+ ******************************************************************************/
+void BinaryImage::dilate(int width, int height)
+{
+  int left, right, above, below;        // Reach of the rectangle
+
+  if (w == 0 || h == 0) return;
+  windowReach(width, left, right);
+  windowReach(height, above, below);
+  rowPass(left, right, true);
+  columnPass(above, below, true);
+}
+
+/***************************************************************************//**
+ * BinaryImage::majority
+ * Author - Dan Andrus
+ *
+ * The binary median over a size x size square: a pixel becomes white if more
+ * than half the pixels under the square are. The white pixels under the
+ * square are counted for 64 pixels at once with bit-sliced adders, each bit
+ * of the count held in its own word, and compared against half the window
+ * the same way.
+ ******************************************************************************/
+void BinaryImage::majority(int size)
+{
+  if (w == 0 || h == 0 || size <= 1) return;
+
+  int side = size;
+  int before, after;                    // Reach of the square
+  int half = side * side / 2;           // More than this many means white
+  int slices = 1;                       // Bits needed for the count
+  int guard;
+
+  windowReach(side, before, after);
+  guard = after / WORD_BITS + 2;
+  unsigned long long mask = lastMask();
+  vector<unsigned long long> result(bits.size());
+
+  while ((1 << slices) <= side * side) slices++;
+
+  #pragma omp parallel
+  {
+    vector< vector<unsigned long long> > ext(side);
+    vector<unsigned long long> sum(slices);
+
+    #pragma omp for
+    for (int y = 0; y < h; y++)
+    {
+      // The rows under the window, repeating the top and bottom rows
+      for (int i = 0; i < side; i++)
+        extendRow(std::max(0, std::min(h - 1, y + i - before)), guard, -1, ext[i]);
+
+      for (int k = 0; k < stride; k++)
+      {
+        unsigned long long gt = 0, eq = ~0ULL, carry, bit;
+        int b;
+
+        for (b = 0; b < slices; b++)
+          sum[b] = 0;
+
+        // Add each of the window's pixels into the bit-sliced count
+        for (int i = 0; i < side; i++)
+        {
+          for (int s = -before; s <= after; s++)
+          {
+            carry = shiftedWord(&ext[i][0], guard + k, s);
+            for (b = 0; b < slices && carry; b++)
+            {
+              bit = sum[b];
+              sum[b] = bit ^ carry;
+              carry &= bit;
+            }
+          }
+        }
+
+        // Compare the count with half the window, most significant bit first
+        for (b = slices - 1; b >= 0; b--)
+        {
+          if ((half >> b) & 1)
+            eq &= sum[b];
+          else
+          {
+            gt |= eq & sum[b];
+            eq &= ~sum[b];
+          }
+        }
+
+        result[(size_t)y * stride + k] = gt;
+      }
+      result[(size_t)y * stride + stride - 1] &= mask;
+    }
+  }
+
+  bits.swap(result);
+}
+
+/***************************************************************************//**
+ * BinaryImage::width
+ * Author - Dan Andrus
+ *
+ * Returns
+ *          The number of columns
+ ******************************************************************************/
+int BinaryImage::width() const
+{
+  return w;
+}
+
+/***************************************************************************//**
+ * BinaryImage::height
+ * Author - Dan Andrus
+ *
+ * Returns
+ *          The number of rows
+ ******************************************************************************/
+int BinaryImage::height() const
+{
+  return h;
+}
+
+/***************************************************************************//**
+ * BinaryImage::words
+ * Author - Dan Andrus
+ *
+ * Returns
+ *          The number of words in each row
+ ******************************************************************************/
+int BinaryImage::words() const
+{
+  return stride;
+}
+
+/***************************************************************************//**
+ * BinaryImage::row
+ * Author - Dan Andrus
+ *
+ * Returns
+ *          The words of row y, for scanning whole words at a time
+ ******************************************************************************/
+const unsigned long long* BinaryImage::row(int y) const
+{
+  return &bits[(size_t) y * stride];
+}
+
+/***************************************************************************//**
+ * BinaryImage::bytesUsed
+ * Author - Dan Andrus
+ *
+ * Returns
+ *          The memory held by the pixels
+ ******************************************************************************/
+size_t BinaryImage::bytesUsed() const
+{
+  return bits.size() * sizeof(bits[0]);
+}
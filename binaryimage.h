@@ -0,0 +1,59 @@
+/***************************************************************************//**
+ * binaryimage.h
+ *
+ * Author - Dan Andrus
+ *
+ * Date - October 18, 2026
+ *
+ * Details - Contains the declarations for the bit-packed binary image and
+ * its word-parallel operations.
+ *
+ ******************************************************************************/
+
+#pragma once
+#include "planes.h"
+
+/***************************************************************************//**
+ * BinaryImage
+ *
+ * Author - Dan Andrus
+ *
+ * A black and white image stored one bit per pixel, 64 pixels to a word. Bit
+ * k of word w of a row is pixel 64w + k; bits past the end of a row are kept
+ * clear. Erosion, dilation and the majority filter work on whole words with
+ * shifts and bitwise logic, so 64 pixels are handled per operation. Their
+ * windows may be any size; even sizes put the center left of and above the
+ * middle, as the masks in toolbox.cpp do.
+ ******************************************************************************/
+class BinaryImage
+{
+  public:
+    BinaryImage();
+    void resize(int w, int h);
+    bool fromPlanes(const ImagePlanes& planes, int threshold);
+    bool fromImage(Image& image, int threshold);
+    void toPlanes(ImagePlanes& planes) const;
+    void toImage(Image& image) const;
+    bool get(int x, int y) const;
+    void set(int x, int y, bool value);
+    long long count() const;
+    void erode(int width, int height);
+    void dilate(int width, int height);
+    void majority(int size);
+    int width() const;
+    int height() const;
+    int words() const;
+    const unsigned long long* row(int y) const;
+    size_t bytesUsed() const;
+
+  private:
+    void extendRow(int y, int guard, int fill, vector<unsigned long long>& ext) const;
+    void rowPass(int left, int right, bool dilate);
+    void columnPass(int above, int below, bool dilate);
+    unsigned long long lastMask() const;
+
+    int w;                              // Columns
+    int h;                              // Rows
+    int stride;                         // Words per row
+    vector<unsigned long long> bits;    // Row-major words
+};
@@ -0,0 +1,301 @@
+/***************************************************************************//**
+ * canny.cpp
+ *
+ * Author - Derek Stotz
+ *
+ * Date - October 18, 2026
+ *
+ * Details - The Canny edge detector. The intensity plane is smoothed with the
+ * recursive Gaussian, then the Sobel gradient and non-maximum suppression run
+ * together in one pass over bands of rows, keeping only three rows of
+ * gradient magnitudes per thread. The surviving pixels are marked strong or
+ * weak by the two thresholds, and hysteresis grows the strong edges into the
+ * weak pixels touching them from a work list rather than by recursion, so
+ * long edges cannot overflow the stack.
+ *
+ ******************************************************************************/
+
+#include "canny.h"
+#include "gaussian.h"
+#include "region.h"
+#include "resultcache.h"
+
+// Rows handled together by one thread in the gradient pass
+static const int CANNY_BAND = 32;
+
+// Pixel classes in the edge map before hysteresis
+static const uchar NotEdge = 0;
+static const uchar WeakEdge = 1;
+static const uchar StrongEdge = 255;
+
+/***************************************************************************//**
+ * gradientRow
+ * Author - Derek Stotz
+ *
+ * The Sobel gradient and its magnitude for a whole row of the smoothed plane.
+ *
+ * Parameters -
+ *          data - the smoothed plane
+ *          w - columns in the plane
+ *          h - rows in the plane
+ *          y - the row, which may be just outside the plane
+ *          gx - receives the horizontal gradient
+ *          gy - receives the vertical gradient
+ *          mag - receives the magnitude
+ ******************************************************************************/
+static void gradientRow(const float* data, int w, int h, int y,
+                        float* gx, float* gy, float* mag)
+{
+  int yc = std::max(0, std::min(h - 1, y));
+  const float* above = data + (size_t) std::max(0, yc - 1) * w;
+  const float* below = data + (size_t) std::min(h - 1, yc + 1) * w;
+
+  sobelRow(above, data + (size_t) yc * w, below, w, 0, w, gx, gy);
+  for (int x = 0; x < w; x++)
+    mag[x] = sqrtf(gx[x] * gx[x] + gy[x] * gy[x]);
+}
+
+/***************************************************************************//**
+ * suppressBand
+ * Author - Derek Stotz
+ *
+ * Finds the gradient, thins it to local maxima across the edge and applies
+ * the two thresholds for rows y0 to y1 - 1. A pixel survives if its magnitude
+ * is greater than the neighbour behind it and at least the one in front
+ * along the gradient direction, quantized to one of four directions, so a
+ * plateau two pixels wide leaves one edge pixel.
+ *
+ * Parameters -
+ *          data - the smoothed plane
+ *          w - columns in the plane
+ *          h - rows in the plane
+ *          y0 - first row
+ *          y1 - one past the last row
+ *          low - weakest magnitude kept
+ *          high - weakest magnitude that starts an edge
+ *          edges - receives the classes of the rows
+ ******************************************************************************/
+static void suppressBand(const float* data, int w, int h, int y0, int y1,
+                         float low, float high, uchar* edges)
+{
+  const float tan22 = 0.41421356f;      // tan(22.5 degrees)
+  const float tan67 = 2.41421356f;      // tan(67.5 degrees)
+  vector<float> gx(w), gy(w);           // Gradient of the middle row
+  vector<float> next_gx(w), next_gy(w); // Gradient of the row below
+  vector<float> rows(3 * (size_t) w);   // Magnitudes of three rows
+  float* mag[3];                        // The rows above, at and below y
+  float* spare;                         // Temporary variable
+
+  mag[0] = &rows[0];
+  mag[1] = &rows[w];
+  mag[2] = &rows[2 * w];
+
+  // Magnitudes outside the image repeat the border rows
+  gradientRow(data, w, h, y0 - 1, &next_gx[0], &next_gy[0], mag[0]);
+  gradientRow(data, w, h, y0, &gx[0], &gy[0], mag[1]);
+
+  for (int y = y0; y < y1; y++)
+  {
+    gradientRow(data, w, h, y + 1, &next_gx[0], &next_gy[0], mag[2]);
+
+    uchar* out = edges + (size_t) y * w;
+    for (int x = 0; x < w; x++)
+    {
+      float m = mag[1][x];
+      float ax = fabsf(gx[x]), ay = fabsf(gy[x]);
+      int l = x > 0 ? x - 1 : 0;
+      int r = x < w - 1 ? x + 1 : w - 1;
+      float behind, ahead;              // Neighbours along the gradient
+
+      if (m < low)
+      {
+        out[x] = NotEdge;
+        continue;
+      }
+
+      if (ay <= ax * tan22)             // Gradient across columns
+      {
+        behind = mag[1][l];
+        ahead = mag[1][r];
+      }
+      else if (ay >= ax * tan67)        // Gradient across rows
+      {
+        behind = mag[0][x];
+        ahead = mag[2][x];
+      }
+      else if ((gx[x] > 0) == (gy[x] > 0))  // Down and right, or up and left
+      {
+        behind = mag[0][l];
+        ahead = mag[2][r];
+      }
+      else                              // Down and left, or up and right
+      {
+        behind = mag[0][r];
+        ahead = mag[2][l];
+      }
+
+      if (m > behind && m >= ahead)
+        out[x] = m >= high ? StrongEdge : WeakEdge;
+      else
+        out[x] = NotEdge;
+    }
+
+    // Move the rows up for the next pixel row
+    spare = mag[0];
+    mag[0] = mag[1];
+    mag[1] = mag[2];
+    mag[2] = spare;
+    gx.swap(next_gx);
+    gy.swap(next_gy);
+  }
+}
+
+/***************************************************************************//**
+ * hysteresis
+ * Author - Derek Stotz
+ *
+ * Turns weak pixels connected to a strong one into strong pixels and drops
+ * the rest. Each thread starts from the strong pixels of its own rows and
+ * follows edges across the whole image with its own work list; a weak pixel
+ * is claimed with an atomic compare and swap so exactly one thread follows it.
+ *
+ * Parameters -
+ *          edges - the classified pixels, left as 0 or 255
+ *          w - columns in the image
+ *          h - rows in the image
+ ******************************************************************************/
+static void hysteresis(vector<uchar>& edges, int w, int h)
+{
+  uchar* e = &edges[0];
+
+  #pragma omp parallel
+  {
+    vector<int> work;                   // Strong pixels still to follow
+
+    #pragma omp for schedule(dynamic, CANNY_BAND)
+    for (int y = 0; y < h; y++)
+    {
+      for (int x = 0; x < w; x++)
+      {
+        if (e[(size_t) y * w + x] != StrongEdge) continue;
+
+        work.push_back(y * w + x);
+        while (!work.empty())
+        {
+          int k = work.back();
+          int cy = k / w, cx = k % w;
+
+          work.pop_back();
+          for (int i = std::max(0, cy - 1); i <= std::min(h - 1, cy + 1); i++)
+            for (int j = std::max(0, cx - 1); j <= std::min(w - 1, cx + 1); j++)
+              if (e[(size_t) i * w + j] == WeakEdge &&
+                  __sync_bool_compare_and_swap(&e[(size_t) i * w + j], WeakEdge, StrongEdge))
+                work.push_back(i * w + j);
+        }
+      }
+    }
+
+    // Weak pixels never reached are not edges
+    #pragma omp for
+    for (int y = 0; y < h; y++)
+      for (int x = 0; x < w; x++)
+        if (e[(size_t) y * w + x] == WeakEdge)
+          e[(size_t) y * w + x] = NotEdge;
+  }
+}
+
+/***************************************************************************//**
+ * cannyEdges
+ * Author - Derek Stotz
+ *
+ * Finds thin, connected edges in the intensity plane of an unpacked image.
+ * The thresholds are in Sobel magnitude units, where a step of one gray level
+ * across a straight edge gives 4.
+ *
+ * Parameters -
+ *          planes - the unpacked image
+ *          sigma - standard deviation of the smoothing, or 0 for none
+ *          low - weakest gradient magnitude an edge may continue through
+ *          high - weakest gradient magnitude that starts an edge
+ *          edges - receives 255 for edge pixels and 0 for the rest
+ *
+ * Returns
+ *          True if the operation was successful, false if not
+ ******************************************************************************/
+bool cannyEdges(const ImagePlanes& planes, double sigma, float low, float high,
+                vector<uchar>& edges)
+{
+  int w = planes.width;
+  int h = planes.height;
+  size_t n = (size_t) w * h;
+  vector<float> data(n);                // Smoothed intensities
+
+  if (n == 0 || low > high) return false;
+
+  #pragma omp parallel for
+  for (long long k = 0; k < (long long) n; k++)
+    data[k] = planes.intensity[k];
+
+  if (sigma > 0)
+    gaussianFloat(&data[0], w, h, sigma);
+
+  edges.resize(n);
+
+  #pragma omp parallel for schedule(dynamic)
+  for (int y0 = 0; y0 < h; y0 += CANNY_BAND)
+    suppressBand(&data[0], w, h, y0, std::min(h, y0 + CANNY_BAND), low, high, &edges[0]);
+
+  hysteresis(edges, w, h);
+  return true;
+}
+
+/***************************************************************************//**
+ * cannyImage
+ * Author - Derek Stotz
+ *
+ * Replaces the active regions of an image with its Canny edges, white on
+ * black. Results are kept in the result cache.
+ *
+ * Parameters -
+ *          image - the image object to manipulate
+ *          sigma - standard deviation of the smoothing, or 0 for none
+ *          low - weakest gradient magnitude an edge may continue through
+ *          high - weakest gradient magnitude that starts an edge
+ *
+ * Returns
+ *          True if the operation was successful, false if not
+ ******************************************************************************/
+bool cannyImage(Image& image, double sigma, int low, int high)
+{
+  ImagePlanes planes;
+  ImagePlanes result;
+  vector<uchar> edges;
+  unsigned long long hash;              // Hash of the original image
+  char key[64];
+
+  if (image.IsNull() || low > high) return false;
+
+  // The edges of the whole image are kept, whatever regions are active
+  sprintf(key, "canny %g %d %d", sigma, low, high);
+  unpackImage(image, planes);
+  hash = hashPlanes(planes);
+
+  if (!resultCache().lookup(key, hash, result))
+  {
+    if (!cannyEdges(planes, sigma, (float) low, (float) high, edges))
+      return false;
+
+    result.width = planes.width;
+    result.height = planes.height;
+    result.red.swap(edges);
+    result.green = result.red;
+    result.blue = result.red;
+    result.gray = true;
+
+    resultCache().store(key, hash, result);
+  }
+
+  packRegions(result, 0, 0, imageRegions(result.width, result.height), image);
+
+  return true;
+}
@@ -0,0 +1,52 @@
+/***************************************************************************//**
+ * canny.h
+ *
+ * Author - Derek Stotz
+ *
+ * Date - October 18, 2026
+ *
+ * Details - Contains the declarations for the shared Sobel gradient stage and
+ * the Canny edge detector built on it.
+ *
+ ******************************************************************************/
+
+#pragma once
+#include "planes.h"
+
+/***************************************************************************//**
+ * sobelRow
+ * Author - Derek Stotz
+ *
+ * The Sobel gradient of columns x0 to x1 - 1 of one row of a plane. Rows above
+ * and below the image should be passed as the nearest row, and columns past
+ * the edges repeat the nearest pixel, as in the mask-based filters. Works on
+ * any numeric plane, so the 8-bit Sobel filters and the floating point Canny
+ * detector share it.
+ *
+ * Parameters -
+ *          above - the row above
+ *          row - the row
+ *          below - the row below
+ *          w - columns in a row
+ *          x0 - first column
+ *          x1 - one past the last column
+ *          gx - receives the horizontal gradient, indexed by column
+ *          gy - receives the vertical gradient, indexed by column
+ ******************************************************************************/
+template <class T, class G>
+inline void sobelRow(const T* above, const T* row, const T* below, int w,
+                     int x0, int x1, G* gx, G* gy)
+{
+  for (int x = x0; x < x1; x++)
+  {
+    int l = x > 0 ? x - 1 : 0;          // Column to the left
+    int r = x < w - 1 ? x + 1 : w - 1;  // Column to the right
+
+    gx[x] = (G) ((above[r] - above[l]) + 2 * (row[r] - row[l]) + (below[r] - below[l]));
+    gy[x] = (G) ((below[l] - above[l]) + 2 * (below[x] - above[x]) + (below[r] - above[r]));
+  }
+}
+
+bool cannyEdges(const ImagePlanes& planes, double sigma, float low, float high,
+                vector<uchar>& edges);
+bool cannyImage(Image& image, double sigma, int low, int high);
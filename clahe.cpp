@@ -0,0 +1,285 @@
+/***************************************************************************//**
+ * clahe.cpp
+ *
+ * Author - Derek Stotz
+ *
+ * Date - October 18, 2026
+ *
+ * Details - Contrast-limited adaptive histogram equalization of the intensity
+ * plane. Each neighborhood's histogram is clipped at a multiple of its mean
+ * bin count and the clipped counts are spread evenly over all the bins before
+ * the histogram is equalized, which stops flat areas from having their noise
+ * stretched across the whole range.
+ *
+ * The tiled form equalizes a grid of tiles and blends the four nearest tile
+ * tables for each pixel. The sliding form equalizes every pixel by its own
+ * window, using a histogram per column that moves down a row at a time and a
+ * window histogram that moves across by adding one column histogram and
+ * subtracting another. The window at the start of each strip of columns also
+ * moves down a row at a time, so each pixel costs two passes over the 256
+ * bins plus about 4r / CLAHE_STRIP updates for keeping the strip's column
+ * and starting histograms current.
+ *
+ ******************************************************************************/
+
+#include "clahe.h"
+
+// Columns handled together by one thread in the sliding form
+static const int CLAHE_STRIP = 128;
+
+/***************************************************************************//**
+ * clipHistogram
+ * Author - Derek Stotz
+ *
+ * Clips a histogram and spreads the clipped counts evenly, any remainder
+ * going to the lowest bins, then builds the equalization table from it.
+ *
+ * Parameters -
+ *          histogram - counts of each level in the neighborhood
+ *          total - number of pixels counted
+ *          clip - limit as a multiple of the mean bin count
+ *          table - receives the new value of each level
+ ******************************************************************************/
+static void clipHistogram(uint histogram[256], uint total, double clip, uchar table[256])
+{
+  uint limit = (uint) std::max(1.0, clip * total / 256.0);
+  uint excess = 0, share, extra, tally = 0;
+  int i;
+
+  for (i = 0; i < 256; i++)
+  {
+    if (histogram[i] > limit)
+    {
+      excess += histogram[i] - limit;
+      histogram[i] = limit;
+    }
+  }
+
+  share = excess / 256;
+  extra = excess % 256;
+  for (i = 0; i < 256; i++)
+  {
+    tally += histogram[i] + share + (i < (int) extra ? 1 : 0);
+    table[i] = (uchar) std::min(255.0, tally * 255.0 / total + 0.5);
+  }
+}
+
+/***************************************************************************//**
+ * claheTiles
+ * Author - Derek Stotz
+ *
+ * Tiled CLAHE. The tables of all the tiles are built in parallel, histogram,
+ * clipping and all; each pixel is then mapped by the tables of the four
+ * tiles whose centers surround it, weighted by distance.
+ *
+ * Parameters -
+ *          src - the intensity plane
+ *          dst - receives the equalized plane
+ *          w - columns in the plane
+ *          h - rows in the plane
+ *          tiles_x - tiles across
+ *          tiles_y - tiles down
+ *          clip - histogram limit as a multiple of the mean bin count
+ ******************************************************************************/
+void claheTiles(const uchar* src, uchar* dst, int w, int h, int tiles_x,
+                int tiles_y, double clip)
+{
+  int tx = std::max(1, std::min(tiles_x, w));
+  int ty = std::max(1, std::min(tiles_y, h));
+  vector<uchar> tables((size_t) tx * ty * 256);
+  vector<int> left(w), top(h);          // Tile whose center is at or before
+  vector<float> fx(w), fy(h);           // Weight of the next tile
+
+  #pragma omp parallel for schedule(dynamic)
+  for (int t = 0; t < tx * ty; t++)
+  {
+    int x0 = (t % tx) * w / tx, x1 = (t % tx + 1) * w / tx;
+    int y0 = (t / tx) * h / ty, y1 = (t / tx + 1) * h / ty;
+    uint histogram[256] = { 0 };
+
+    for (int y = y0; y < y1; y++)
+      for (int x = x0; x < x1; x++)
+        histogram[src[(size_t) y * w + x]]++;
+
+    clipHistogram(histogram, (x1 - x0) * (y1 - y0), clip, &tables[(size_t) t * 256]);
+  }
+
+  // Where each column and row sits between tile centers
+  for (int x = 0; x < w; x++)
+  {
+    float pos = std::max(0.0f, std::min((float) (tx - 1), (x + 0.5f) * tx / w - 0.5f));
+    left[x] = std::min(tx - 2, (int) pos);
+    if (tx == 1) left[x] = 0;
+    fx[x] = tx == 1 ? 0 : pos - left[x];
+  }
+  for (int y = 0; y < h; y++)
+  {
+    float pos = std::max(0.0f, std::min((float) (ty - 1), (y + 0.5f) * ty / h - 0.5f));
+    top[y] = std::min(ty - 2, (int) pos);
+    if (ty == 1) top[y] = 0;
+    fy[y] = ty == 1 ? 0 : pos - top[y];
+  }
+
+  #pragma omp parallel for
+  for (int y = 0; y < h; y++)
+  {
+    int down = ty == 1 ? 0 : tx;        // Offset to the tile below
+    for (int x = 0; x < w; x++)
+    {
+      int v = src[(size_t) y * w + x];
+      int right = tx == 1 ? 0 : 1;      // Offset to the tile to the right
+      const uchar* t = &tables[(size_t) (top[y] * tx + left[x]) * 256 + v];
+      float a = t[0], b = t[right * 256];
+      float c = t[down * 256], d = t[(down + right) * 256];
+      float upper = a + fx[x] * (b - a), lower = c + fx[x] * (d - c);
+
+      dst[(size_t) y * w + x] = (uchar) (upper + fy[y] * (lower - upper) + 0.5f);
+    }
+  }
+}
+
+/***************************************************************************//**
+ * claheSliding
+ * Author - Derek Stotz
+ *
+ * CLAHE with a (2r + 1) square window centered on every pixel. The window
+ * repeats the border pixels, so every window holds the same number of pixels.
+ * Each thread takes a strip of columns, keeping histograms for its columns
+ * and r columns either side, and the window histogram of the strip's first
+ * column, all of which move down one row at a time.
+ *
+ * Parameters -
+ *          src - the intensity plane
+ *          dst - receives the equalized plane
+ *          w - columns in the plane
+ *          h - rows in the plane
+ *          r - window radius
+ *          clip - histogram limit as a multiple of the mean bin count
+ ******************************************************************************/
+void claheSliding(const uchar* src, uchar* dst, int w, int h, int r, double clip)
+{
+  uint total = (uint) (2 * r + 1) * (2 * r + 1);
+  uint limit = (uint) std::max(1.0, clip * total / 256.0);
+
+  #pragma omp parallel for schedule(dynamic)
+  for (int x0 = 0; x0 < w; x0 += CLAHE_STRIP)
+  {
+    int x1 = std::min(w, x0 + CLAHE_STRIP);
+    int c0 = std::max(0, x0 - r), c1 = std::min(w - 1, x1 - 1 + r);
+    int cols = c1 - c0 + 1;
+    vector<uint> column((size_t) cols * 256, 0);  // Histograms of columns c0 to c1
+    vector<int> first(2 * r + 1);       // Columns of the strip's first window
+    uint start[256] = { 0 };            // Window histogram of column x0
+    uint window[256];
+
+    for (int k = 0; k <= 2 * r; k++)
+      first[k] = std::max(0, std::min(w - 1, x0 - r + k));
+
+    for (int y = -r; y <= r; y++)
+    {
+      const uchar* row = src + (size_t) std::max(0, std::min(h - 1, y)) * w;
+      for (int c = 0; c < cols; c++)
+        column[(size_t) c * 256 + row[c0 + c]]++;
+      for (int k = 0; k <= 2 * r; k++)
+        start[row[first[k]]]++;
+    }
+
+    for (int y = 0; y < h; y++)
+    {
+      const uchar* row = src + (size_t) y * w;
+      uchar* out = dst + (size_t) y * w;
+
+      std::copy(start, start + 256, window);
+
+      for (int x = x0; x < x1; x++)
+      {
+        int v = row[x];
+        uint below = 0, above = 0;      // Clipped counts up to v, and past it
+        int i;
+
+        #pragma omp simd reduction(+:below)
+        for (i = 0; i <= v; i++)
+          below += std::min(window[i], limit);
+        #pragma omp simd reduction(+:above)
+        for (i = v + 1; i < 256; i++)
+          above += std::min(window[i], limit);
+
+        // The clipped counts are spread evenly, as in clipHistogram
+        out[x] = (uchar) std::min(255.0,
+          (below + (double) (total - below - above) * (v + 1) / 256) * 255.0 / total + 0.5);
+
+        // Slide the window one column right
+        if (x + 1 < x1)
+        {
+          const uint* add = &column[(size_t) (std::min(w - 1, x + 1 + r) - c0) * 256];
+          const uint* sub = &column[(size_t) (std::max(0, x - r) - c0) * 256];
+          #pragma omp simd
+          for (int b = 0; b < 256; b++)
+            window[b] += add[b] - sub[b];
+        }
+      }
+
+      // Slide the column histograms and the first window one row down
+      if (y + 1 < h)
+      {
+        const uchar* enter = src + (size_t) std::min(h - 1, y + 1 + r) * w;
+        const uchar* leave = src + (size_t) std::max(0, y - r) * w;
+        for (int c = 0; c < cols; c++)
+        {
+          column[(size_t) c * 256 + enter[c0 + c]]++;
+          column[(size_t) c * 256 + leave[c0 + c]]--;
+        }
+        for (int k = 0; k <= 2 * r; k++)
+        {
+          start[enter[first[k]]]++;
+          start[leave[first[k]]]--;
+        }
+      }
+    }
+  }
+}
+
+/***************************************************************************//**
+ * claheImage
+ * Author - Derek Stotz
+ *
+ * Equalizes the intensity of the active regions of an image, keeping hue as
+ * the global equalization does. A radius above zero selects the sliding
+ * window; otherwise the image is split into tiles.
+ *
+ * Parameters -
+ *          image - the image object to manipulate
+ *          tiles_x - tiles across, for the tiled form
+ *          tiles_y - tiles down, for the tiled form
+ *          radius - window radius for the sliding form, or 0
+ *          clip - histogram limit as a multiple of the mean bin count
+ *
+ * Returns
+ *          True if the operation was successful, false if not
+ ******************************************************************************/
+bool claheImage(Image& image, int tiles_x, int tiles_y, int radius, double clip)
+{
+  ImagePlanes planes;
+  vector<uchar> out;
+  vector<Rect> rects;
+  int w, r;
+
+  if (image.IsNull() || clip <= 0) return false;
+
+  unpackImage(image, planes);
+  w = planes.width;
+  out.resize(planes.intensity.size());
+
+  if (radius > 0)
+    claheSliding(&planes.intensity[0], &out[0], w, planes.height, radius, clip);
+  else
+    claheTiles(&planes.intensity[0], &out[0], w, planes.height, tiles_x, tiles_y, clip);
+
+  rects = imageRegions(w, planes.height);
+  for (r = 0; r < (int) rects.size(); r++)
+    for (int i = rects[r].y; i < rects[r].y + rects[r].h; i++)
+      for (int j = rects[r].x; j < rects[r].x + rects[r].w; j++)
+        image[i][j].SetIntensity(out[(size_t) i * w + j]);
+
+  return true;
+}
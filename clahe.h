@@ -0,0 +1,19 @@
+/***************************************************************************//**
+ * clahe.h
+ *
+ * Author - Derek Stotz
+ *
+ * Date - October 18, 2026
+ *
+ * Details - Contains the declarations for contrast-limited adaptive histogram
+ * equalization.
+ *
+ ******************************************************************************/
+
+#pragma once
+#include "planes.h"
+
+void claheTiles(const uchar* src, uchar* dst, int w, int h, int tiles_x,
+                int tiles_y, double clip);
+void claheSliding(const uchar* src, uchar* dst, int w, int h, int r, double clip);
+bool claheImage(Image& image, int tiles_x, int tiles_y, int radius, double clip);
@@ -0,0 +1,35 @@
+/***************************************************************************//**
+ * components.h
+ *
+ * Author - Dan Andrus
+ *
+ * Date - October 18, 2026
+ *
+ * Details - Contains the declarations for connected component labeling of
+ * binary images.
+ *
+ ******************************************************************************/
+
+#pragma once
+#include "binaryimage.h"
+
+// Which neighbors join pixels into one component
+enum connectivity { Connect4, Connect8 };
+
+/***************************************************************************//**
+ * Blob
+ *
+ * Author - Dan Andrus
+ *
+ * Statistics of one connected component.
+ ******************************************************************************/
+struct Blob
+{
+  long long area;                       // Pixels in the component
+  Rect box;                             // Bounding box
+  double cx;                            // Centroid column
+  double cy;                            // Centroid row
+};
+
+int labelComponents(const BinaryImage& mask, connectivity conn,
+                    vector<int>& labels, vector<Blob>& blobs);
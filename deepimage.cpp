@@ -0,0 +1,375 @@
+/***************************************************************************//**
+ * deepimage.cpp
+ *
+ * Author - Derek Stotz
+ *
+ * Date - October 18, 2026
+ *
+ * Details - Greyscale images with more than 8 bits per pixel. The filters
+ * themselves are the templated ones used on 8-bit planes (see neighborhood.h
+ * and sparsemask.h); this file reads and writes 16-bit PGM files, converts
+ * to and from QtImageLib images, and adds the point processes that need a
+ * histogram of all 65536 values. Smoothing that needs fractions between
+ * levels goes through a floating point copy of the plane.
+ *
+ ******************************************************************************/
+
+#include "deepimage.h"
+#include "gaussian.h"
+#include <climits>
+#include <fstream>
+#include <limits>
+
+/***************************************************************************//**
+ * skipSpace
+ * Author - Derek Stotz
+ *
+ * Skips white space and comment lines in the header of a PGM file.
+ ******************************************************************************/
+static void skipSpace(istream& in)
+{
+  while ((in >> ws).peek() == '#')
+    in.ignore(numeric_limits<streamsize>::max(), '\n');
+}
+
+/***************************************************************************//**
+ * readPgm
+ * Author - Derek Stotz
+ *
+ * Reads a binary (P5) or text (P2) PGM file. Files with a maxval above 255
+ * store two bytes per pixel, most significant first, and are read at full
+ * depth; 8-bit files are read as they are.
+ *
+ * Parameters -
+ *          path - the file to read
+ *          plane - receives the image, with maxval taken from the file
+ *
+ * Returns
+ *          True if the file was read, false if it could not be opened or is
+ *          not a valid PGM file
+ ******************************************************************************/
+bool readPgm(const string& path, Plane16& plane)
+{
+  ifstream file(path.c_str(), ios::binary);
+  string magic;                         // P5 for binary, P2 for text
+  long long w, h, maxval;               // Header fields
+  size_t n, k;                          // Temporary variables
+
+  if (!(file >> magic) || (magic != "P5" && magic != "P2"))
+    return false;
+
+  skipSpace(file);
+  file >> w;
+  skipSpace(file);
+  file >> h;
+  skipSpace(file);
+  file >> maxval;
+  if (!file || w < 1 || h < 1 || maxval < 1 || maxval > 65535 || w * h > INT_MAX)
+    return false;
+
+  n = (size_t) (w * h);
+  plane.width = (int) w;
+  plane.height = (int) h;
+  plane.maxval = (unsigned short) maxval;
+  plane.data.resize(n);
+
+  if (magic == "P2")
+  {
+    long long v;
+    for (k = 0; k < n; k++)
+    {
+      skipSpace(file);
+      if (!(file >> v)) return false;
+      plane.data[k] = (unsigned short) max(0LL, min(maxval, v));
+    }
+    return true;
+  }
+
+  // A single white space character separates the header from the pixels
+  file.get();
+
+  int bytes = maxval > 255 ? 2 : 1;     // Bytes per pixel
+  vector<unsigned char> raw(n * bytes);
+
+  if (!file.read((char*) &raw[0], raw.size()))
+    return false;
+
+  #pragma omp parallel for
+  for (long long i = 0; i < (long long) n; i++)
+  {
+    int v = bytes == 2 ? (raw[2 * i] << 8) | raw[2 * i + 1] : raw[i];
+    plane.data[i] = (unsigned short) min((int) maxval, v);
+  }
+
+  return true;
+}
+
+/***************************************************************************//**
+ * writePgm
+ * Author - Derek Stotz
+ *
+ * Writes a plane as a binary (P5) PGM file with the plane's maxval, using two
+ * bytes per pixel when it is above 255. Pixels above maxval are clipped.
+ *
+ * Parameters -
+ *          path - the file to write
+ *          plane - the image to write
+ *
+ * Returns
+ *          True if the file was written, false if not
+ ******************************************************************************/
+bool writePgm(const string& path, const Plane16& plane)
+{
+  if (plane.width < 1 || plane.height < 1 || plane.maxval < 1) return false;
+
+  ofstream file(path.c_str(), ios::binary);
+  size_t n = plane.data.size();         // Pixels in the plane
+  int bytes = plane.maxval > 255 ? 2 : 1;  // Bytes per pixel
+  vector<unsigned char> raw(n * bytes);
+
+  #pragma omp parallel for
+  for (long long i = 0; i < (long long) n; i++)
+  {
+    int v = min(plane.data[i], plane.maxval);
+    if (bytes == 2)
+    {
+      raw[2 * i] = (unsigned char) (v >> 8);
+      raw[2 * i + 1] = (unsigned char) (v & 255);
+    }
+    else
+      raw[i] = (unsigned char) v;
+  }
+
+  file << "P5\n" << plane.width << " " << plane.height << "\n" << plane.maxval << "\n";
+  file.write((const char*) &raw[0], raw.size());
+
+  return (bool) file;
+}
+
+/***************************************************************************//**
+ * deepFromImage
+ * Author - Derek Stotz
+ *
+ * Takes the intensities of an 8-bit image into a 16-bit plane, so that the
+ * 16-bit processes can be used on any image. 255 becomes 65535.
+ *
+ * Parameters -
+ *          image - the image to read
+ *          plane - receives the intensities, with maxval 65535
+ *
+ * Returns
+ *          True if the operation was successful, false if the image is null
+ ******************************************************************************/
+bool deepFromImage(Image& image, Plane16& plane)
+{
+  if (image.IsNull()) return false;
+
+  int i, j, k;                          // Temporary variables
+
+  plane.width = image.Width();
+  plane.height = image.Height();
+  plane.maxval = 65535;
+  plane.data.resize((size_t) plane.width * plane.height);
+
+  // 257 spreads 0-255 evenly over 0-65535
+  for (i = 0, k = 0; i < plane.height; ++i)
+    for (j = 0; j < plane.width; ++j, ++k)
+      plane.data[k] = image[i][j].Intensity() * 257;
+
+  return true;
+}
+
+/***************************************************************************//**
+ * deepToImage
+ * Author - Derek Stotz
+ *
+ * Scales a deep plane down to 8 bits for display, maxval becoming 255.
+ *
+ * Parameters -
+ *          plane - the plane to show
+ *          image - receives a gray image the size of the plane
+ *
+ * Returns
+ *          True if the operation was successful, false if the plane is empty
+ ******************************************************************************/
+bool deepToImage(const Plane16& plane, Image& image)
+{
+  if (plane.width < 1 || plane.height < 1 || plane.maxval < 1) return false;
+
+  vector<uchar> lut(65536);             // 8-bit value of each deep value
+  int i, j, k;                          // Temporary variables
+
+  for (k = 0; k < 65536; k++)
+    lut[k] = (uchar) ((min(k, (int) plane.maxval) * 255 + plane.maxval / 2) / plane.maxval);
+
+  image = Image(plane.height, plane.width);
+  for (i = 0, k = 0; i < plane.height; ++i)
+    for (j = 0; j < plane.width; ++j, ++k)
+      image[i][j].SetGray(lut[plane.data[k]]);
+
+  return true;
+}
+
+/***************************************************************************//**
+ * medianDeep
+ * Author - Derek Stotz
+ *
+ * Median filters a 16-bit plane with a square window using the running
+ * two-level histogram of rankorder.cpp, so the cost per pixel follows the
+ * window width rather than its area, as for 8-bit images.
+ *
+ * Parameters -
+ *          src - the plane to filter
+ *          dst - receives the filtered plane; must not be src
+ *          mask_w - the width (and height) of the window
+ *
+ * Returns
+ *          True if the operation was successful, false if not
+ ******************************************************************************/
+bool medianDeep(const Plane16& src, Plane16& dst, int mask_w)
+{
+  if (src.width < 1 || src.height < 1 || mask_w < 1) return false;
+
+  dst.width = src.width;
+  dst.height = src.height;
+  dst.maxval = src.maxval;
+  dst.data.resize(src.data.size());
+
+  medianPlane(&src.data[0], &dst.data[0], src.width, src.height, mask_w);
+  return true;
+}
+
+/***************************************************************************//**
+ * equalizeDeep
+ * Author - Derek Stotz
+ *
+ * Histogram equalization of a 16-bit plane over all of its levels, the same
+ * mapping the 8-bit Equalize process uses with 256 replaced by maxval + 1.
+ * Threads count separate histograms that are then added together.
+ *
+ * Parameters -
+ *          plane - the plane to equalize
+ *
+ * Returns
+ *          True if the operation was successful, false if the plane is empty
+ ******************************************************************************/
+bool equalizeDeep(Plane16& plane)
+{
+  if (plane.data.empty() || plane.maxval < 1) return false;
+
+  long long n = (long long) plane.data.size();  // Pixels in the plane
+  int levels = plane.maxval + 1;        // Values a pixel can have
+  vector<long long> histogram(levels, 0);
+  vector<unsigned short> lut(65536);    // New value of each value
+  long long tally = 0;
+  int k, tmp;
+
+  #pragma omp parallel
+  {
+    vector<long long> local(levels, 0); // This thread's histogram
+
+    #pragma omp for nowait
+    for (long long i = 0; i < n; i++)
+      local[min((int) plane.data[i], levels - 1)]++;
+
+    #pragma omp critical
+    for (int v = 0; v < levels; v++)
+      histogram[v] += local[v];
+  }
+
+  // Build lookup table based on histogram
+  for (k = 0; k < levels; k++)
+  {
+    tally += histogram[k];
+    tmp = (int) (tally / (n / (double) levels));
+    if (tmp < 0) tmp = 0;
+    if (tmp > plane.maxval) tmp = plane.maxval;
+    lut[k] = (unsigned short) tmp;
+  }
+  for (; k < 65536; k++)
+    lut[k] = plane.maxval;
+
+  #pragma omp parallel for
+  for (long long i = 0; i < n; i++)
+    plane.data[i] = lut[plane.data[i]];
+
+  return true;
+}
+
+/***************************************************************************//**
+ * deepToFloat
+ * Author - Derek Stotz
+ *
+ * Converts a 16-bit plane to floating point, scaled so maxval becomes 1.
+ *
+ * Parameters -
+ *          src - the plane to convert
+ *          dst - receives the floating point plane, with maxval 1
+ ******************************************************************************/
+void deepToFloat(const Plane16& src, PlaneFloat& dst)
+{
+  float scale = src.maxval > 0 ? 1.0f / src.maxval : 1.0f;
+
+  dst.width = src.width;
+  dst.height = src.height;
+  dst.maxval = 1.0f;
+  dst.data.resize(src.data.size());
+
+  #pragma omp parallel for
+  for (long long i = 0; i < (long long) src.data.size(); i++)
+    dst.data[i] = src.data[i] * scale;
+}
+
+/***************************************************************************//**
+ * deepFromFloat
+ * Author - Derek Stotz
+ *
+ * Converts a floating point plane back to 16 bits, rounding and clipping.
+ * The result keeps the maxval dst already has, or 65535 if it has none.
+ *
+ * Parameters -
+ *          src - the plane to convert, with values scaled to src.maxval
+ *          dst - receives the 16-bit plane
+ ******************************************************************************/
+void deepFromFloat(const PlaneFloat& src, Plane16& dst)
+{
+  if (dst.maxval < 1) dst.maxval = 65535;
+
+  float scale = dst.maxval / (src.maxval > 0 ? src.maxval : 1.0f);
+  float top = dst.maxval;               // Largest value kept
+
+  dst.width = src.width;
+  dst.height = src.height;
+  dst.data.resize(src.data.size());
+
+  #pragma omp parallel for
+  for (long long i = 0; i < (long long) src.data.size(); i++)
+    dst.data[i] = (unsigned short) (max(0.0f, min(top, src.data[i] * scale)) + 0.5f);
+}
+
+/***************************************************************************//**
+ * gaussianDeep
+ * Author - Derek Stotz
+ *
+ * Smooths a 16-bit plane with a Gaussian of any sigma. The recursive filter
+ * works on floating point values, so the plane is converted to float, smoothed
+ * and rounded back once, rather than rounded after every pass.
+ *
+ * Parameters -
+ *          plane - the plane to smooth
+ *          sigma - standard deviation of the Gaussian, in pixels
+ *
+ * Returns
+ *          True if the operation was successful, false if not
+ ******************************************************************************/
+bool gaussianDeep(Plane16& plane, double sigma)
+{
+  if (plane.data.empty() || sigma <= 0) return false;
+
+  PlaneFloat values;                    // The plane, scaled to [0, 1]
+
+  deepToFloat(plane, values);
+  gaussianFloat(&values.data[0], values.width, values.height, sigma);
+  deepFromFloat(values, plane);
+  return true;
+}
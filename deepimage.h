@@ -0,0 +1,79 @@
+/***************************************************************************//**
+ * deepimage.h
+ *
+ * Author - Derek Stotz
+ *
+ * Date - October 18, 2026
+ *
+ * Details - Contains the declarations for greyscale images with more than
+ * 8 bits per pixel, such as the 12 and 16-bit output of scientific cameras,
+ * and for reading and writing them as 16-bit PGM files.
+ *
+ ******************************************************************************/
+
+#pragma once
+#include "sparsemask.h"
+#include "rankorder.h"
+
+/***************************************************************************//**
+ * DeepPlane
+ *
+ * Author - Derek Stotz
+ *
+ * One greyscale plane of any pixel type. maxval is the value that means full
+ * white: 65535 for 16-bit data, 4095 for a 12-bit camera, 1 for float data
+ * scaled to [0, 1]. QtImageLib images only hold 8 bits, so a deep plane is
+ * kept alongside the image and only scaled down to show it.
+ ******************************************************************************/
+template <class T>
+struct DeepPlane
+{
+  int width;                            // Columns in the plane
+  int height;                           // Rows in the plane
+  T maxval;                             // Value of full white
+  vector<T> data;                       // Pixels, row by row
+
+  DeepPlane() : width(0), height(0), maxval(0) {}
+};
+
+typedef DeepPlane<unsigned short> Plane16;
+typedef DeepPlane<float> PlaneFloat;
+
+/***************************************************************************//**
+ * filterDeep
+ * Author - Derek Stotz
+ *
+ * Runs a neighborhood reducer (see neighborhood.h) over a whole deep plane.
+ *
+ * Parameters -
+ *          src - the plane to filter
+ *          dst - receives the filtered plane; must not be src
+ *          reducer - computes one output value from a neighborhood
+ *
+ * Returns
+ *          True if the operation was successful, false if the plane is empty
+ ******************************************************************************/
+template <class T, class Reducer>
+bool filterDeep(const DeepPlane<T>& src, DeepPlane<T>& dst, const Reducer& reducer)
+{
+  if (src.width < 1 || src.height < 1) return false;
+
+  dst.width = src.width;
+  dst.height = src.height;
+  dst.maxval = src.maxval;
+  dst.data.resize(src.data.size());
+
+  neighborhoodPlane(&src.data[0], &dst.data[0], src.width, src.height,
+                    makeRect(0, 0, src.width, src.height), reducer);
+  return true;
+}
+
+bool readPgm(const string& path, Plane16& plane);
+bool writePgm(const string& path, const Plane16& plane);
+bool deepFromImage(Image& image, Plane16& plane);
+bool deepToImage(const Plane16& plane, Image& image);
+bool medianDeep(const Plane16& src, Plane16& dst, int mask_w);
+bool equalizeDeep(Plane16& plane);
+bool gaussianDeep(Plane16& plane, double sigma);
+void deepToFloat(const Plane16& src, PlaneFloat& dst);
+void deepFromFloat(const PlaneFloat& src, Plane16& dst);
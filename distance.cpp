@@ -0,0 +1,277 @@
+/***************************************************************************//**
+ * distance.cpp
+ *
+ * Author - Derek Stotz
+ *
+ * Date - October 18, 2026
+ *
+ * Details - Distance transforms, giving every pixel its distance to the
+ * nearest white pixel. The exact transform is the separable algorithm of
+ * Felzenszwalb and Huttenlocher: a scan along each row finds the distance to
+ * the nearest white pixel in the row, and each column then takes the lower
+ * envelope of the parabolas rooted at its pixels, which gives exact squared
+ * Euclidean distances in time linear in the number of pixels. Rows and then
+ * columns are spread across threads. The chamfer transform is the classic
+ * two-pass 3-4 approximation.
+ *
+ ******************************************************************************/
+
+#include "distance.h"
+
+// Columns gathered together by one thread in the column pass
+static const int DIST_BLOCK = 16;
+
+/***************************************************************************//**
+ * lowerEnvelope
+ * Author - Derek Stotz
+ *
+ * One-dimensional squared distance transform of a sampled function:
+ *   d(q) = min over p of (q - p)^2 + f(p)
+ * Entries of f equal to NO_DISTANCE are ignored.
+ *
+ * Parameters -
+ *          f - the function, n values
+ *          n - number of values
+ *          d - receives the transform; may not be f
+ *          v - scratch for n parabola roots
+ *          z - scratch for n + 1 boundaries
+ ******************************************************************************/
+static void lowerEnvelope(const int* f, int n, int* d, int* v, double* z)
+{
+  int k = -1;                           // Last parabola in the envelope
+  int q, p;
+
+  for (q = 0; q < n; q++)
+  {
+    double s = 0;
+
+    if (f[q] == NO_DISTANCE) continue;
+
+    // Drop parabolas the new one hides
+    while (k >= 0)
+    {
+      p = v[k];
+      s = ((f[q] + (double) q * q) - (f[p] + (double) p * p)) / (2.0 * (q - p));
+      if (s > z[k]) break;
+      k--;
+    }
+
+    k++;
+    v[k] = q;
+    z[k] = k == 0 ? -1e30 : s;
+    z[k + 1] = 1e30;
+  }
+
+  if (k < 0)
+  {
+    for (q = 0; q < n; q++)
+      d[q] = NO_DISTANCE;
+    return;
+  }
+
+  for (q = 0, k = 0; q < n; q++)
+  {
+    while (z[k + 1] < q) k++;
+    p = v[k];
+    d[q] = (q - p) * (q - p) + f[p];
+  }
+}
+
+/***************************************************************************//**
+ * squaredDistance
+ * Author - Derek Stotz
+ *
+ * Exact squared Euclidean distance from every pixel to the nearest white
+ * pixel, or NO_DISTANCE everywhere if there is none.
+ *
+ * Parameters -
+ *          mask - the binary image
+ *          dist2 - receives the squared distances, row-major
+ ******************************************************************************/
+void squaredDistance(const BinaryImage& mask, vector<int>& dist2)
+{
+  int w = mask.width();
+  int h = mask.height();
+
+  dist2.resize((size_t) w * h);
+  if (w == 0 || h == 0) return;
+
+  // Along each row, the squared distance to the nearest white pixel in it
+  #pragma omp parallel for
+  for (int y = 0; y < h; y++)
+  {
+    int* row = &dist2[(size_t) y * w];
+    int last = -1;                      // Last white pixel seen
+    int x;
+
+    for (x = 0; x < w; x++)
+    {
+      if (mask.get(x, y)) last = x;
+      row[x] = last < 0 ? -1 : x - last;
+    }
+    last = -1;
+    for (x = w - 1; x >= 0; x--)
+    {
+      if (mask.get(x, y)) last = x;
+      if (last >= 0 && (row[x] < 0 || last - x < row[x]))
+        row[x] = last - x;
+      row[x] = row[x] < 0 ? NO_DISTANCE : row[x] * row[x];
+    }
+  }
+
+  // Down each column, the lower envelope of the row distances
+  #pragma omp parallel
+  {
+    vector<int> d(h), v(h);
+    vector<double> z(h + 1);
+    vector<int> block((size_t) DIST_BLOCK * h);
+
+    #pragma omp for
+    for (int x0 = 0; x0 < w; x0 += DIST_BLOCK)
+    {
+      int n = std::min(DIST_BLOCK, w - x0);
+      int x, y;
+
+      // Gather a block of columns at once so the reads run along rows
+      for (y = 0; y < h; y++)
+        for (x = 0; x < n; x++)
+          block[(size_t) x * h + y] = dist2[(size_t) y * w + x0 + x];
+
+      for (x = 0; x < n; x++)
+      {
+        lowerEnvelope(&block[(size_t) x * h], h, &d[0], &v[0], &z[0]);
+        std::copy(d.begin(), d.end(), block.begin() + (size_t) x * h);
+      }
+
+      for (y = 0; y < h; y++)
+        for (x = 0; x < n; x++)
+          dist2[(size_t) y * w + x0 + x] = block[(size_t) x * h + y];
+    }
+  }
+}
+
+/***************************************************************************//**
+ * chamferDistance
+ * Author - Derek Stotz
+ *
+ * Approximate distance to the nearest white pixel by the 3-4 chamfer: steps
+ * across or down cost 3 and diagonal steps cost 4, so the result is three
+ * times the distance, to within about 8 percent. Two raster passes.
+ *
+ * Parameters -
+ *          mask - the binary image
+ *          dist3 - receives three times the distances, row-major, or
+ *                  NO_DISTANCE everywhere if there is no white pixel
+ ******************************************************************************/
+void chamferDistance(const BinaryImage& mask, vector<int>& dist3)
+{
+  int w = mask.width();
+  int h = mask.height();
+  int far = 3 * (w + h) + 4;            // More than any real distance
+  int x, y;
+
+  dist3.resize((size_t) w * h);
+  if (w == 0 || h == 0) return;
+
+  #pragma omp parallel for
+  for (int i = 0; i < h; i++)
+    for (int j = 0; j < w; j++)
+      dist3[(size_t) i * w + j] = mask.get(j, i) ? 0 : far;
+
+  // Forward pass: neighbors above and to the left
+  for (y = 0; y < h; y++)
+  {
+    int* row = &dist3[(size_t) y * w];
+    int* up = y > 0 ? row - w : 0;
+    for (x = 0; x < w; x++)
+    {
+      int d = row[x];
+      if (x > 0)                  d = std::min(d, row[x - 1] + 3);
+      if (up)                     d = std::min(d, up[x] + 3);
+      if (up && x > 0)            d = std::min(d, up[x - 1] + 4);
+      if (up && x < w - 1)        d = std::min(d, up[x + 1] + 4);
+      row[x] = d;
+    }
+  }
+
+  // Backward pass: neighbors below and to the right
+  for (y = h - 1; y >= 0; y--)
+  {
+    int* row = &dist3[(size_t) y * w];
+    int* down = y < h - 1 ? row + w : 0;
+    for (x = w - 1; x >= 0; x--)
+    {
+      int d = row[x];
+      if (x < w - 1)              d = std::min(d, row[x + 1] + 3);
+      if (down)                   d = std::min(d, down[x] + 3);
+      if (down && x < w - 1)      d = std::min(d, down[x + 1] + 4);
+      if (down && x > 0)          d = std::min(d, down[x - 1] + 4);
+      row[x] = d;
+    }
+  }
+
+  if (dist3[0] >= far)
+    std::fill(dist3.begin(), dist3.end(), NO_DISTANCE);
+}
+
+/***************************************************************************//**
+ * distanceImage
+ * Author - Derek Stotz
+ *
+ * Thresholds an image and replaces its active regions with the distance of
+ * each pixel to the nearest white pixel, times scale, as gray levels clipped
+ * at 255. Pixels with no white pixel to measure to are white.
+ *
+ * Parameters -
+ *          image - the image object to manipulate
+ *          threshold - lowest intensity taken as white
+ *          metric - how the distance is measured
+ *          scale - gray levels per unit of distance
+ *
+ * Returns
+ *          True if the operation was successful, false if not
+ ******************************************************************************/
+bool distanceImage(Image& image, int threshold, distanceMetric metric, double scale)
+{
+  BinaryImage mask;
+  ImagePlanes planes;
+  vector<int> dist;
+  double unit;                          // Distance per stored unit
+  int n;
+
+  if (image.IsNull() || !mask.fromImage(image, threshold)) return false;
+
+  if (metric == ChamferDistance)
+    chamferDistance(mask, dist);
+  else
+    squaredDistance(mask, dist);
+  unit = metric == ChamferDistance ? 1.0 / 3 : 1.0;
+
+  n = (int) dist.size();
+  planes.width = mask.width();
+  planes.height = mask.height();
+  planes.red.resize(n);
+
+  #pragma omp parallel for
+  for (int k = 0; k < n; k++)
+  {
+    double d;
+
+    if (dist[k] == NO_DISTANCE)
+      d = 255;
+    else if (metric == EuclideanDistance)
+      d = sqrt((double) dist[k]) * scale;
+    else
+      d = dist[k] * unit * scale;
+    planes.red[k] = (uchar) std::min(255.0, d + 0.5);
+  }
+
+  planes.green = planes.red;
+  planes.blue = planes.red;
+  planes.intensity = planes.red;
+  planes.gray = true;
+
+  packRegions(planes, 0, 0, imageRegions(planes.width, planes.height), image);
+
+  return true;
+}
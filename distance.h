@@ -0,0 +1,30 @@
+/***************************************************************************//**
+ * distance.h
+ *
+ * Author - Derek Stotz
+ *
+ * Date - October 18, 2026
+ *
+ * Details - Contains the declarations for distance transforms of binary
+ * images.
+ *
+ ******************************************************************************/
+
+#pragma once
+#include "binaryimage.h"
+#include <climits>
+
+// Squared distance given to pixels when the image has no white pixels
+static const int NO_DISTANCE = INT_MAX;
+
+// How distances are measured
+enum distanceMetric
+{
+  EuclideanDistance,                    // Exact straight line distance
+  SquaredDistance,                      // Exact, squared, in whole pixels
+  ChamferDistance                       // 3-4 chamfer approximation
+};
+
+void squaredDistance(const BinaryImage& mask, vector<int>& dist2);
+void chamferDistance(const BinaryImage& mask, vector<int>& dist3);
+bool distanceImage(Image& image, int threshold, distanceMetric metric, double scale);
@@ -0,0 +1,303 @@
+/***************************************************************************//**
+ * gaussian.cpp
+ *
+ * Author - Dan Andrus
+ *
+ * Date - October 18, 2026
+ *
+ * Details - Gaussian smoothing with Deriche's fourth order recursive filter.
+ * Each row and then each column is run through a causal and an anti-causal
+ * IIR filter whose coefficients are fitted to the Gaussian, so the work per
+ * pixel is the same whatever sigma is. Borders repeat the nearest pixel, as
+ * the mask-based filters in toolbox.cpp do. The recursion is carried in
+ * double precision; with large sigma the poles sit close to 1 and float
+ * state drifts by several gray levels.
+ *
+ ******************************************************************************/
+
+#include "gaussian.h"
+
+// Columns handled together by the vertical pass
+static const int COLUMN_BLOCK = 64;
+
+/***************************************************************************//**
+ * DericheCoefficients
+ *
+ * Author - Dan Andrus
+ *
+ * Coefficients of the causal (n) and anti-causal (m) halves of the filter and
+ * their shared feedback terms (d), plus the steady state gain of each half for
+ * a constant input, which is used to start the filter at the borders.
+ ******************************************************************************/
+struct DericheCoefficients
+{
+  double n[4];                          // Causal feed-forward, taps 0 to 3
+  double m[5];                          // Anti-causal feed-forward, taps 1 to 4
+  double d[5];                          // Feedback, taps 1 to 4
+  double causal_gain;                   // Causal output for a constant 1
+  double anticausal_gain;               // Anti-causal output for a constant 1
+};
+
+/***************************************************************************//**
+ * dericheCoefficients
+ * Author - Dan Andrus
+ *
+ * Derives the filter coefficients for a given sigma from Deriche's two-term
+ * fit of the Gaussian,
+ *   (a0 cos(w0 x) + a1 sin(w0 x)) exp(-b0 x) + (c0 cos(w1 x) + c1 sin(w1 x)) exp(-b1 x)
+ * with x in units of sigma. The result is normalized to unit DC gain.
+ *
+ * Parameters -
+ *          sigma - standard deviation of the Gaussian, in pixels
+ *          c - receives the coefficients
+ ******************************************************************************/
+static void dericheCoefficients(double sigma, DericheCoefficients& c)
+{
+  const double a0 = 1.680, a1 = 3.735, b0 = 1.783, w0 = 0.6318;
+  const double c0 = -0.6803, c1 = -0.2598, b1 = 1.723, w1 = 1.997;
+
+  double q0 = exp(-b0 / sigma);         // Decay of the first term
+  double q1 = exp(-b1 / sigma);         // Decay of the second term
+  double cos0 = cos(w0 / sigma), sin0 = sin(w0 / sigma);
+  double cos1 = cos(w1 / sigma), sin1 = sin(w1 / sigma);
+  double n[4], m[5], d[5];              // Unnormalized coefficients
+  double p0[2], p1[2];                  // Numerators of each term
+  double e0[3], e1[3];                  // Denominators of each term
+  double sum_n, sum_m, sum_d, gain;     // Sums for the DC gain
+  int k;                                // Temporary variable
+
+  // Each term is a second order section: numerator and denominator in z^-1
+  p0[0] = a0;
+  p0[1] = q0 * (a1 * sin0 - a0 * cos0);
+  p1[0] = c0;
+  p1[1] = q1 * (c1 * sin1 - c0 * cos1);
+  e0[0] = 1;  e0[1] = -2 * q0 * cos0;  e0[2] = q0 * q0;
+  e1[0] = 1;  e1[1] = -2 * q1 * cos1;  e1[2] = q1 * q1;
+
+  // Sum the two sections over a common fourth order denominator
+  n[0] = p0[0] + p1[0];
+  n[1] = p0[1] + p0[0] * e1[1] + p1[1] + p1[0] * e0[1];
+  n[2] = p0[0] * e1[2] + p0[1] * e1[1] + p1[0] * e0[2] + p1[1] * e0[1];
+  n[3] = p0[1] * e1[2] + p1[1] * e0[2];
+
+  d[0] = 1;
+  d[1] = e0[1] + e1[1];
+  d[2] = e0[2] + e1[2] + e0[1] * e1[1];
+  d[3] = e0[1] * e1[2] + e1[1] * e0[2];
+  d[4] = e0[2] * e1[2];
+
+  // The Gaussian is symmetric, so the anti-causal half mirrors the causal one
+  m[0] = 0;
+  for (k = 1; k < 4; k++)
+    m[k] = n[k] - d[k] * n[0];
+  m[4] = -d[4] * n[0];
+
+  sum_n = n[0] + n[1] + n[2] + n[3];
+  sum_m = m[1] + m[2] + m[3] + m[4];
+  sum_d = d[1] + d[2] + d[3] + d[4];
+  gain = (sum_n + sum_m) / (1 + sum_d);
+
+  for (k = 0; k < 4; k++)
+    c.n[k] = n[k] / gain;
+  for (k = 0; k < 5; k++)
+  {
+    c.m[k] = m[k] / gain;
+    c.d[k] = d[k];
+  }
+  c.causal_gain = sum_n / gain / (1 + sum_d);
+  c.anticausal_gain = sum_m / gain / (1 + sum_d);
+}
+
+/***************************************************************************//**
+ * filterRow
+ * Author - Dan Andrus
+ *
+ * Runs one row through both halves of the filter, in place.
+ *
+ * Parameters -
+ *          row - the values to smooth
+ *          out - scratch space of the same length
+ *          n - number of values in the row
+ *          c - the filter coefficients
+ ******************************************************************************/
+static void filterRow(float* row, double* out, int n, const DericheCoefficients& c)
+{
+  double x1, x2, x3, x4;                // Previous inputs
+  double y1, y2, y3, y4;                // Previous outputs
+  double x0, y0;                        // Current input and output
+  int i;                                // Temporary variable
+
+  // Causal pass, starting as if the first pixel extended forever to the left
+  x1 = x2 = x3 = row[0];
+  y1 = y2 = y3 = y4 = row[0] * c.causal_gain;
+  for (i = 0; i < n; i++)
+  {
+    x0 = row[i];
+    y0 = c.n[0] * x0 + c.n[1] * x1 + c.n[2] * x2 + c.n[3] * x3
+       - c.d[1] * y1 - c.d[2] * y2 - c.d[3] * y3 - c.d[4] * y4;
+    out[i] = y0;
+    x3 = x2; x2 = x1; x1 = x0;
+    y4 = y3; y3 = y2; y2 = y1; y1 = y0;
+  }
+
+  // Anti-causal pass, likewise extending the last pixel to the right
+  x1 = x2 = x3 = x4 = row[n - 1];
+  y1 = y2 = y3 = y4 = row[n - 1] * c.anticausal_gain;
+  for (i = n - 1; i >= 0; i--)
+  {
+    y0 = c.m[1] * x1 + c.m[2] * x2 + c.m[3] * x3 + c.m[4] * x4
+       - c.d[1] * y1 - c.d[2] * y2 - c.d[3] * y3 - c.d[4] * y4;
+    x4 = x3; x3 = x2; x2 = x1; x1 = row[i];
+    y4 = y3; y3 = y2; y2 = y1; y1 = y0;
+    row[i] = (float) (out[i] + y0);
+  }
+}
+
+/***************************************************************************//**
+ * filterColumns
+ * Author - Dan Andrus
+ *
+ * Runs a block of neighbouring columns through both halves of the filter, in
+ * place. The columns are stepped through together one row at a time, so every
+ * inner loop walks contiguous memory.
+ *
+ * Parameters -
+ *          data - the whole plane
+ *          w - columns in the plane
+ *          h - rows in the plane
+ *          x0 - first column of the block
+ *          bw - number of columns in the block
+ *          c - the filter coefficients
+ *          out - scratch space for bw * h values
+ ******************************************************************************/
+static void filterColumns(float* data, int w, int h, int x0, int bw,
+                          const DericheCoefficients& c, double* out)
+{
+  double x[4][COLUMN_BLOCK];            // Previous inputs per column
+  double y[4][COLUMN_BLOCK];            // Previous outputs per column
+  float* row;                           // Current row of the block
+  double in, val;                       // Current input and output
+  int i, j, k;                          // Temporary variables
+
+  // Causal pass, top to bottom
+  for (j = 0; j < bw; j++)
+  {
+    for (k = 0; k < 4; k++)
+    {
+      x[k][j] = data[x0 + j];
+      y[k][j] = data[x0 + j] * c.causal_gain;
+    }
+  }
+  for (i = 0; i < h; i++)
+  {
+    row = data + (size_t) i * w + x0;
+    for (j = 0; j < bw; j++)
+    {
+      in = row[j];
+      val = c.n[0] * in + c.n[1] * x[0][j] + c.n[2] * x[1][j] + c.n[3] * x[2][j]
+          - c.d[1] * y[0][j] - c.d[2] * y[1][j] - c.d[3] * y[2][j] - c.d[4] * y[3][j];
+      out[(size_t) i * bw + j] = val;
+      x[2][j] = x[1][j]; x[1][j] = x[0][j]; x[0][j] = in;
+      y[3][j] = y[2][j]; y[2][j] = y[1][j]; y[1][j] = y[0][j]; y[0][j] = val;
+    }
+  }
+
+  // Anti-causal pass, bottom to top
+  row = data + (size_t) (h - 1) * w + x0;
+  for (j = 0; j < bw; j++)
+  {
+    for (k = 0; k < 4; k++)
+    {
+      x[k][j] = row[j];
+      y[k][j] = row[j] * c.anticausal_gain;
+    }
+  }
+  for (i = h - 1; i >= 0; i--)
+  {
+    row = data + (size_t) i * w + x0;
+    for (j = 0; j < bw; j++)
+    {
+      val = c.m[1] * x[0][j] + c.m[2] * x[1][j] + c.m[3] * x[2][j] + c.m[4] * x[3][j]
+          - c.d[1] * y[0][j] - c.d[2] * y[1][j] - c.d[3] * y[2][j] - c.d[4] * y[3][j];
+      x[3][j] = x[2][j]; x[2][j] = x[1][j]; x[1][j] = x[0][j]; x[0][j] = row[j];
+      y[3][j] = y[2][j]; y[2][j] = y[1][j]; y[1][j] = y[0][j]; y[0][j] = val;
+      row[j] = (float) (out[(size_t) i * bw + j] + val);
+    }
+  }
+}
+
+/***************************************************************************//**
+ * gaussianFloat
+ * Author - Dan Andrus
+ *
+ * Smooths a single floating point plane with a Gaussian of the given sigma,
+ * in place. Rows are filtered in parallel, then blocks of columns.
+ *
+ * Parameters -
+ *          data - the row-major plane to smooth
+ *          w - columns in the plane
+ *          h - rows in the plane
+ *          sigma - standard deviation of the Gaussian, in pixels
+ ******************************************************************************/
+void gaussianFloat(float* data, int w, int h, double sigma)
+{
+  DericheCoefficients c;                // Filter coefficients
+
+  if (w < 1 || h < 1 || sigma <= 0) return;
+
+  dericheCoefficients(sigma, c);
+
+  #pragma omp parallel
+  {
+    vector<double> scratch(std::max(w, COLUMN_BLOCK * h));
+
+    #pragma omp for
+    for (int i = 0; i < h; i++)
+      filterRow(data + (size_t) i * w, &scratch[0], w, c);
+
+    #pragma omp for
+    for (int x0 = 0; x0 < w; x0 += COLUMN_BLOCK)
+      filterColumns(data, w, h, x0, std::min(COLUMN_BLOCK, w - x0), c, &scratch[0]);
+  }
+}
+
+/***************************************************************************//**
+ * gaussianSmooth
+ * Author - Dan Andrus
+ *
+ * Smooths the red, green and blue planes of an unpacked image with a Gaussian
+ * of the given sigma. The intensity plane is left as it was.
+ *
+ * Parameters -
+ *          planes - the unpacked image to manipulate
+ *          sigma - standard deviation of the Gaussian, in pixels
+ *
+ * Returns
+ *          True if the operation was successful, false if not
+ ******************************************************************************/
+bool gaussianSmooth(ImagePlanes& planes, double sigma)
+{
+  int n = planes.width * planes.height; // Values per plane
+  vector<uchar>* channels[3] = { &planes.red, &planes.green, &planes.blue };
+  vector<float> buffer(n);              // Floating point working copy
+  int c, k;                             // Temporary variables
+
+  if (n == 0 || sigma <= 0) return false;
+
+  for (c = 0; c < 3; c++)
+  {
+    vector<uchar>& plane = *channels[c];
+
+    for (k = 0; k < n; k++)
+      buffer[k] = plane[k];
+
+    gaussianFloat(&buffer[0], planes.width, planes.height, sigma);
+
+    // Round and clip back to 8 bits
+    #pragma omp parallel for
+    for (k = 0; k < n; k++)
+      plane[k] = (uchar) std::max(0, std::min(255, (int) (buffer[k] + 0.5f)));
+  }
+
+  return true;
+}
@@ -0,0 +1,16 @@
+/***************************************************************************//**
+ * gaussian.h
+ *
+ * Author - Dan Andrus
+ *
+ * Date - October 18, 2026
+ *
+ * Details - Contains the declarations for recursive Gaussian smoothing.
+ *
+ ******************************************************************************/
+
+#pragma once
+#include "planes.h"
+
+void gaussianFloat(float* data, int w, int h, double sigma);
+bool gaussianSmooth(ImagePlanes& planes, double sigma);
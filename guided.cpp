@@ -0,0 +1,368 @@
+/***************************************************************************//**
+ * guided.cpp
+ *
+ * Author - Derek Stotz
+ *
+ * Date - October 18, 2026
+ *
+ * Details - The guided filter of He, Sun and Tang. Within each window the
+ * output is fitted as a linear function of the guide, a I + b, so edges in
+ * the guide carry through while flat areas are averaged. All the window sums
+ * are box means computed with running sums, so the cost per pixel is the same
+ * for any radius. The fast variant fits a and b on a subsampled copy and
+ * interpolates them back up, which cuts the work by the square of the
+ * subsampling.
+ *
+ ******************************************************************************/
+
+#include "guided.h"
+
+// Columns handled together by one thread in the vertical box pass
+static const int BOX_STRIP = 256;
+
+/***************************************************************************//**
+ * boxMean
+ * Author - Derek Stotz
+ *
+ * The mean over a (2r + 1) square around every pixel. Pixels outside the plane
+ * are left out of the mean rather than repeated, as the guided filter expects.
+ * Running sums are kept in double precision so they do not drift.
+ *
+ * Parameters -
+ *          src - the row-major plane to average
+ *          dst - receives the means; may not be src
+ *          w - columns in the plane
+ *          h - rows in the plane
+ *          r - radius of the square
+ ******************************************************************************/
+void boxMean(const float* src, float* dst, int w, int h, int r)
+{
+  // Down the columns, a strip at a time so each thread walks its own columns
+  #pragma omp parallel
+  {
+    vector<double> sum(BOX_STRIP);
+
+    #pragma omp for
+    for (int x0 = 0; x0 < w; x0 += BOX_STRIP)
+    {
+      int n = std::min(BOX_STRIP, w - x0);
+      int x, y;
+
+      for (x = 0; x < n; x++)
+        sum[x] = 0;
+      for (y = 0; y < std::min(r, h - 1) + 1; y++)
+        for (x = 0; x < n; x++)
+          sum[x] += src[(size_t) y * w + x0 + x];
+
+      for (y = 0; y < h; y++)
+      {
+        float scale = 1.0f / (std::min(h - 1, y + r) - std::max(0, y - r) + 1);
+        float* out = dst + (size_t) y * w + x0;
+
+        for (x = 0; x < n; x++)
+          out[x] = (float) (sum[x] * scale);
+        if (y + r + 1 < h)
+        {
+          const float* add = src + (size_t) (y + r + 1) * w + x0;
+          for (x = 0; x < n; x++)
+            sum[x] += add[x];
+        }
+        if (y - r >= 0)
+        {
+          const float* sub = src + (size_t) (y - r) * w + x0;
+          for (x = 0; x < n; x++)
+            sum[x] -= sub[x];
+        }
+      }
+    }
+  }
+
+  // Then along the rows, in place
+  #pragma omp parallel
+  {
+    vector<float> row(w);
+
+    #pragma omp for
+    for (int y = 0; y < h; y++)
+    {
+      float* line = dst + (size_t) y * w;
+      double sum = 0;
+      int x;
+
+      for (x = 0; x < w; x++)
+        row[x] = line[x];
+      for (x = 0; x < std::min(r, w - 1) + 1; x++)
+        sum += row[x];
+
+      for (x = 0; x < w; x++)
+      {
+        line[x] = (float) (sum / (std::min(w - 1, x + r) - std::max(0, x - r) + 1));
+        if (x + r + 1 < w) sum += row[x + r + 1];
+        if (x - r >= 0) sum -= row[x - r];
+      }
+    }
+  }
+}
+
+/***************************************************************************//**
+ * subsamplePlane
+ * Author - Derek Stotz
+ *
+ * Shrinks a plane by averaging s x s blocks. Blocks at the right and bottom
+ * may be partial.
+ *
+ * Parameters -
+ *          src - the plane to shrink
+ *          w - columns in src
+ *          h - rows in src
+ *          s - block size
+ *          dst - receives the ceil(w / s) x ceil(h / s) plane
+ ******************************************************************************/
+static void subsamplePlane(const float* src, int w, int h, int s, vector<float>& dst)
+{
+  int sw = (w + s - 1) / s;
+  int sh = (h + s - 1) / s;
+
+  dst.resize((size_t) sw * sh);
+
+  #pragma omp parallel for
+  for (int i = 0; i < sh; i++)
+  {
+    for (int j = 0; j < sw; j++)
+    {
+      int y1 = std::min(h, (i + 1) * s), x1 = std::min(w, (j + 1) * s);
+      float sum = 0;
+
+      for (int y = i * s; y < y1; y++)
+        for (int x = j * s; x < x1; x++)
+          sum += src[(size_t) y * w + x];
+      dst[(size_t) i * sw + j] = sum / ((y1 - i * s) * (x1 - j * s));
+    }
+  }
+}
+
+/***************************************************************************//**
+ * upsampleSample
+ * Author - Derek Stotz
+ *
+ * Bilinear interpolation of a subsampled plane at full resolution pixel
+ * (x, y), taking each block's value to sit at the block center.
+ ******************************************************************************/
+static inline float upsampleSample(const float* small, int sw, int sh, int s,
+                                   int x, int y)
+{
+  float fx = (x + 0.5f) / s - 0.5f, fy = (y + 0.5f) / s - 0.5f;
+  int x0, y0, x1, y1;
+
+  fx = std::max(0.0f, std::min((float) (sw - 1), fx));
+  fy = std::max(0.0f, std::min((float) (sh - 1), fy));
+  x0 = (int) fx;
+  y0 = (int) fy;
+  x1 = std::min(sw - 1, x0 + 1);
+  y1 = std::min(sh - 1, y0 + 1);
+  fx -= x0;
+  fy -= y0;
+
+  return (1 - fy) * ((1 - fx) * small[(size_t) y0 * sw + x0] + fx * small[(size_t) y0 * sw + x1])
+       + fy * ((1 - fx) * small[(size_t) y1 * sw + x0] + fx * small[(size_t) y1 * sw + x1]);
+}
+
+/***************************************************************************//**
+ * guidedPlane
+ * Author - Derek Stotz
+ *
+ * Filters one plane with the guided filter. When guide and src are the same
+ * plane the filter is self-guided and two of the box means are shared.
+ *
+ * Parameters -
+ *          guide - the plane whose edges are kept
+ *          src - the plane to filter
+ *          dst - receives the filtered plane; may be src
+ *          w - columns in the planes
+ *          h - rows in the planes
+ *          r - window radius, in full resolution pixels
+ *          eps - regularization, in squared gray levels; windows whose guide
+ *                varies less than this are smoothed
+ *          subsample - fit the coefficients on a copy this many times
+ *                      smaller, or 1 for the exact filter
+ ******************************************************************************/
+void guidedPlane(const float* guide, const float* src, float* dst, int w, int h,
+                 int r, float eps, int subsample)
+{
+  bool self = (guide == src);
+  int s = std::max(1, subsample);
+  int sw = (w + s - 1) / s, sh = (h + s - 1) / s;
+  int sr = std::max(1, r / s);          // Radius at the subsampled size
+  size_t n = (size_t) sw * sh;
+  vector<float> small_i, small_p;       // Subsampled guide and input
+  const float* gi = guide;              // Guide at the working size
+  const float* pi = src;                // Input at the working size
+  vector<float> mean_i(n), mean_p, corr_ii(n), corr_ip, prod(n);
+
+  if (s > 1)
+  {
+    subsamplePlane(guide, w, h, s, small_i);
+    gi = &small_i[0];
+    if (self)
+      pi = gi;
+    else
+    {
+      subsamplePlane(src, w, h, s, small_p);
+      pi = &small_p[0];
+    }
+  }
+  else
+    sr = r;
+
+  // Means of I, p, I * I and I * p over each window
+  boxMean(gi, &mean_i[0], sw, sh, sr);
+
+  #pragma omp parallel for simd
+  for (size_t k = 0; k < n; k++)
+    prod[k] = gi[k] * gi[k];
+  boxMean(&prod[0], &corr_ii[0], sw, sh, sr);
+
+  if (self)
+    mean_p = mean_i;
+  else
+  {
+    mean_p.resize(n);
+    corr_ip.resize(n);
+    boxMean(pi, &mean_p[0], sw, sh, sr);
+
+    #pragma omp parallel for simd
+    for (size_t k = 0; k < n; k++)
+      prod[k] = gi[k] * pi[k];
+    boxMean(&prod[0], &corr_ip[0], sw, sh, sr);
+  }
+
+  // a = cov(I, p) / (var(I) + eps) and b = mean(p) - a mean(I), kept in
+  // corr_ii and prod
+  {
+    const float* cip = self ? &corr_ii[0] : &corr_ip[0];
+
+    #pragma omp parallel for simd
+    for (size_t k = 0; k < n; k++)
+    {
+      float var = corr_ii[k] - mean_i[k] * mean_i[k];
+      float cov = cip[k] - mean_i[k] * mean_p[k];
+      float a = cov / (var + eps);
+      corr_ii[k] = a;
+      prod[k] = mean_p[k] - a * mean_i[k];
+    }
+  }
+
+  // Average the coefficients of every window covering each pixel
+  boxMean(&corr_ii[0], &mean_i[0], sw, sh, sr);
+  boxMean(&prod[0], &mean_p[0], sw, sh, sr);
+
+  if (s == 1)
+  {
+    #pragma omp parallel for simd
+    for (size_t k = 0; k < n; k++)
+      dst[k] = mean_i[k] * guide[k] + mean_p[k];
+  }
+  else
+  {
+    #pragma omp parallel for
+    for (int y = 0; y < h; y++)
+      for (int x = 0; x < w; x++)
+        dst[(size_t) y * w + x] = upsampleSample(&mean_i[0], sw, sh, s, x, y) * guide[(size_t) y * w + x]
+                                + upsampleSample(&mean_p[0], sw, sh, s, x, y);
+  }
+}
+
+/***************************************************************************//**
+ * guidedPlanes
+ * Author - Derek Stotz
+ *
+ * Applies the guided filter to the red, green and blue planes of an unpacked
+ * image. Without a guide each channel guides itself; with one, the guide's
+ * intensity guides every channel. The detail setting blends the result with
+ * the input: 0 gives the smoothed image and values above 1 boost the detail
+ * the filter removed.
+ *
+ * Parameters -
+ *          planes - the unpacked image to manipulate
+ *          guide - an unpacked image of the same size, or null to self-guide
+ *          r - window radius, in pixels
+ *          eps - regularization, in squared gray levels
+ *          subsample - see guidedPlane
+ *          detail - amount of the removed detail to put back
+ *
+ * Returns
+ *          True if the operation was successful, false if not
+ ******************************************************************************/
+bool guidedPlanes(ImagePlanes& planes, const ImagePlanes* guide, int r,
+                  double eps, int subsample, double detail)
+{
+  int n = planes.width * planes.height; // Values per plane
+  vector<uchar>* channels[3] = { &planes.red, &planes.green, &planes.blue };
+  vector<float> src(n), dst(n), cross;  // Working copies
+  int count = planes.gray ? 1 : 3;      // Channels to filter
+  int c;
+
+  if (n == 0 || r < 1 || eps <= 0) return false;
+  if (guide != 0 && (guide->width != planes.width || guide->height != planes.height))
+    return false;
+
+  if (guide != 0)
+  {
+    cross.resize(n);
+    for (int k = 0; k < n; k++)
+      cross[k] = guide->intensity[k];
+  }
+
+  for (c = 0; c < count; c++)
+  {
+    vector<uchar>& plane = *channels[c];
+
+    for (int k = 0; k < n; k++)
+      src[k] = plane[k];
+
+    guidedPlane(guide != 0 ? &cross[0] : &src[0], &src[0], &dst[0],
+                planes.width, planes.height, r, (float) eps, subsample);
+
+    // Blend in the detail, then round and clip back to 8 bits
+    #pragma omp parallel for
+    for (int k = 0; k < n; k++)
+    {
+      float v = dst[k] + (float) detail * (src[k] - dst[k]);
+      plane[k] = (uchar) std::max(0, std::min(255, (int) (v + 0.5f)));
+    }
+  }
+
+  if (planes.gray)
+  {
+    planes.green = planes.red;
+    planes.blue = planes.red;
+  }
+
+  return true;
+}
+
+/***************************************************************************//**
+ * guidedImage
+ * Author - Derek Stotz
+ *
+ * Applies the guided filter to the active regions of an image (see
+ * guidedPlanes).
+ *
+ * Returns
+ *          True if the operation was successful, false if not
+ ******************************************************************************/
+bool guidedImage(Image& image, const ImagePlanes* guide, int r, double eps,
+                 int subsample, double detail)
+{
+  ImagePlanes planes;
+
+  if (image.IsNull()) return false;
+
+  unpackImage(image, planes);
+  if (!guidedPlanes(planes, guide, r, eps, subsample, detail))
+    return false;
+
+  packRegions(planes, 0, 0, imageRegions(planes.width, planes.height), image);
+
+  return true;
+}
@@ -0,0 +1,22 @@
+/***************************************************************************//**
+ * guided.h
+ *
+ * Author - Derek Stotz
+ *
+ * Date - October 18, 2026
+ *
+ * Details - Contains the declarations for the box filter and the guided
+ * filter built on it.
+ *
+ ******************************************************************************/
+
+#pragma once
+#include "planes.h"
+
+void boxMean(const float* src, float* dst, int w, int h, int r);
+void guidedPlane(const float* guide, const float* src, float* dst, int w, int h,
+                 int r, float eps, int subsample);
+bool guidedPlanes(ImagePlanes& planes, const ImagePlanes* guide, int r,
+                  double eps, int subsample, double detail);
+bool guidedImage(Image& image, const ImagePlanes* guide, int r, double eps,
+                 int subsample, double detail);
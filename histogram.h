@@ -0,0 +1,19 @@
+/***************************************************************************//**
+ * histogram.h
+ *
+ * Author - Dan Andrus
+ *
+ * Date - October 18, 2026
+ *
+ * Details - Contains the declarations for the histogram engine shared by the
+ * histogram-based point processes.
+ *
+ ******************************************************************************/
+
+#pragma once
+#include "planes.h"
+
+// Which plane of an image a histogram is taken over
+enum channel { RedChannel, GreenChannel, BlueChannel, IntensityChannel };
+
+bool imageHistogram(Image& image, channel ch, uint histogram[256]);
@@ -0,0 +1,125 @@
+/***************************************************************************//**
+ * imagestats.cpp
+ *
+ * Author - Derek Stotz
+ *
+ * Date - October 18, 2026
+ *
+ * Details - Single-pass intensity statistics. The pixels are only touched by
+ * the histogram engine; min, max, mean, variance and the cut points are then
+ * read off the 256 bins.
+ *
+ ******************************************************************************/
+
+#include "imagestats.h"
+#include "histogram.h"
+
+/***************************************************************************//**
+ * imageStats
+ * Author - Derek Stotz
+ *
+ * Computes the intensity statistics of an image from its intensity
+ * histogram, which is counted straight from the pixels by the parallel
+ * histogram engine. Nothing is cached between calls: checking a cache would
+ * mean hashing every pixel, which costs as much as counting them again.
+ *
+ * Parameters -
+ *          image - the image to measure
+ *          stats - receives the statistics
+ *
+ * Returns
+ *          True if the operation was successful, false if the image is null
+ ******************************************************************************/
+bool imageStats(Image& image, ImageStats& stats)
+{
+  double sum = 0;                       // Sum of intensities
+  double squares = 0;                   // Sum of squared intensities
+  int i;                                // Temporary variable
+
+  if (!imageHistogram(image, IntensityChannel, stats.histogram))
+    return false;
+
+  stats.count = image.Width() * image.Height();
+  stats.min = 255;
+  stats.max = 0;
+
+  for (i = 0; i < 256; i++)
+  {
+    if (stats.histogram[i] == 0) continue;
+
+    stats.min = std::min(stats.min, i);
+    stats.max = std::max(stats.max, i);
+    sum += (double) stats.histogram[i] * i;
+    squares += (double) stats.histogram[i] * i * i;
+  }
+
+  // An empty image has no spread
+  if (stats.count == 0)
+  {
+    stats.min = stats.max = 0;
+    stats.mean = stats.variance = 0;
+    return true;
+  }
+
+  stats.mean = sum / stats.count;
+  stats.variance = squares / stats.count - stats.mean * stats.mean;
+  if (stats.variance < 0) stats.variance = 0;
+
+  return true;
+}
+
+/***************************************************************************//**
+ * statsLowerCut
+ * Author - Derek Stotz
+ *
+ * Finds the intensity reached once the darkest percentage of pixels has been
+ * ignored, counting up from black.
+ *
+ * Parameters -
+ *          stats - the image statistics
+ *          percent - the percentage of pixels to ignore, 0 to 100
+ *
+ * Returns
+ *          The lowest intensity kept
+ ******************************************************************************/
+int statsLowerCut(const ImageStats& stats, double percent)
+{
+  int ignore = (int) ((percent / 100.0) * stats.count);
+
+  for (int i = 0; i < 256; i++)
+  {
+    ignore -= stats.histogram[i];
+    if (ignore <= 0)
+      return i;
+  }
+
+  return 255;
+}
+
+/***************************************************************************//**
+ * statsUpperCut
+ * Author - Derek Stotz
+ *
+ * Finds the intensity reached once the brightest percentage of pixels has
+ * been ignored, counting down from white.
+ *
+ * Parameters -
+ *          stats - the image statistics
+ *          percent - the percentage of pixels to ignore, 0 to 100
+ *
+ * Returns
+ *          The highest intensity kept
+ ******************************************************************************/
+int statsUpperCut(const ImageStats& stats, double percent)
+{
+  int ignore = (int) ((percent / 100.0) * stats.count);
+
+  for (int i = 255; i > 0; i--)
+  {
+    ignore -= stats.histogram[i];
+    if (ignore <= 0)
+      return i;
+  }
+
+  return 0;
+}
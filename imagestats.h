@@ -0,0 +1,36 @@
+/***************************************************************************//**
+ * imagestats.h
+ *
+ * Author - Derek Stotz
+ *
+ * Date - October 18, 2026
+ *
+ * Details - Contains the declaration for the ImageStats structure and the
+ * functions that compute and query it.
+ *
+ ******************************************************************************/
+
+#pragma once
+#include "toolbox.h"
+
+/***************************************************************************//**
+ * ImageStats
+ *
+ * Author - Derek Stotz
+ *
+ * Intensity statistics of an image. Everything here follows from the
+ * intensity histogram, so one counting pass over the pixels fills it all in.
+ ******************************************************************************/
+struct ImageStats
+{
+  int count;                            // Number of pixels
+  int min;                              // Lowest intensity present
+  int max;                              // Highest intensity present
+  double mean;                          // Mean intensity
+  double variance;                      // Population variance of intensity
+  uint histogram[256];                  // Intensity histogram
+};
+
+bool imageStats(Image& image, ImageStats& stats);
+int statsLowerCut(const ImageStats& stats, double percent);
+int statsUpperCut(const ImageStats& stats, double percent);
@@ -0,0 +1,61 @@
+/***************************************************************************//**
+ * lut.h
+ *
+ * Author - Derek Stotz
+ *
+ * Date - October 18, 2026
+ *
+ * Details - Contains the declarations for the lookup table engine used by the
+ * point processes.
+ *
+ ******************************************************************************/
+
+#pragma once
+#include "region.h"
+
+// What a lookup table is indexed by and what it writes back
+enum lutTarget
+{
+  LutChannels,                          // red, green and blue each mapped
+  LutIntensity,                         // intensity mapped, hue kept
+  LutGray                               // intensity mapped, result is gray
+};
+
+/***************************************************************************//**
+ * PointLut
+ *
+ * Author - Derek Stotz
+ *
+ * A point process expressed as a 256-entry table, along with what the table
+ * is applied to.
+ ******************************************************************************/
+struct PointLut
+{
+  lutTarget target;                     // How the table is applied
+  uchar table[256];                     // New value for each old value
+};
+
+/***************************************************************************//**
+ * LutChain
+ *
+ * Author - Derek Stotz
+ *
+ * Collects point processes without touching the image. Each table pushed is
+ * folded into the previous one whenever the two compose, so apply() costs one
+ * pass over the image per group of composable tables instead of one pass per
+ * table.
+ ******************************************************************************/
+class LutChain
+{
+  public:
+    void push(const PointLut& lut);
+    bool apply(Image& image);
+
+  private:
+    vector<PointLut> pending;           // Tables that could not be folded
+};
+
+void lutClip(PointLut& lut, const int values[256], lutTarget target);
+void lutStretch(PointLut& lut, int low, int high);
+bool lutCompose(PointLut& first, const PointLut& second);
+bool applyLut(Image& image, const PointLut& lut, const vector<Rect>* regions = 0);
@@ -0,0 +1,61 @@
+/***************************************************************************//**
+ * morphology.h
+ *
+ * Author - Derek Stotz
+ *
+ * Date - October 18, 2026
+ *
+ * Details - Contains the declarations for grey-level morphology with
+ * decomposed structuring elements.
+ *
+ ******************************************************************************/
+
+#pragma once
+#include "planes.h"
+
+// Shapes of structuring element
+enum morphShape { RectShape, DiskShape, LineShape, DiamondShape };
+
+// Morphological operations
+enum morphOp { Erode, Dilate, Open, Close, TopHat, Gradient };
+
+/***************************************************************************//**
+ * StructElement
+ *
+ * Author - Derek Stotz
+ *
+ * A structuring element. Rectangles are width x height; disks and diamonds
+ * are width across; lines are width long at angle degrees anticlockwise from
+ * horizontal. Even sizes put the center left of and above the middle, as the
+ * masks in toolbox.cpp do.
+ ******************************************************************************/
+struct StructElement
+{
+  morphShape shape;                     // Which shape
+  int width;                            // Width, diameter or length
+  int height;                           // Height of a rectangle
+  int angle;                            // Angle of a line, in degrees
+};
+
+/***************************************************************************//**
+ * MorphStep
+ *
+ * Author - Derek Stotz
+ *
+ * One piece of a decomposed structuring element. A line step covers the
+ * points first..last times the unit step (dx, dy) and is run with the van
+ * Herk/Gil-Werman algorithm in three compares per pixel whatever its length.
+ * Any other step lists its points and is run directly.
+ ******************************************************************************/
+struct MorphStep
+{
+  bool line;                            // Line step or list of points
+  int dx, dy;                           // Unit step of a line, each -1, 0 or 1
+  int first, last;                      // Range of multiples of the step
+  vector<int> x, y;                     // Points of a non-line step
+};
+
+void decomposeElement(const StructElement& se, vector<MorphStep>& steps);
+void morphPlane(uchar* plane, int w, int h, const vector<MorphStep>& steps, bool dilate);
+bool morphPlanes(ImagePlanes& planes, const StructElement& se, morphOp op);
+bool morphImage(Image& image, const StructElement& se, morphOp op);
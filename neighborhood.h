@@ -0,0 +1,399 @@
+/***************************************************************************//**
+ * neighborhood.h
+ *
+ * Author - Dan Andrus
+ *
+ * Date - October 18, 2026
+ *
+ * Details - A template framework for the neighborhood filters. The loops every
+ * filter shares (visiting each pixel of a rectangle, clamping at the image
+ * edge, tiling and threading) are written here once. A filter supplies only
+ * a reducer: a small struct that turns the pixels under its mask into one
+ * output value. Reducers are template parameters, so every call is resolved
+ * when the filter is compiled and nothing virtual runs per pixel. Both are
+ * templated on the pixel type, so the same reducers run on the 8-bit image
+ * planes and on 16-bit planes.
+ *
+ ******************************************************************************/
+
+#pragma once
+#include "planes.h"
+#include "resultcache.h"
+
+// Rows per band when a filter is spread over threads
+static const int NEIGHBORHOOD_BAND = 16;
+
+// Columns per tile; keeps the padded rows of one tile in cache
+static const int NEIGHBORHOOD_TILE = 512;
+
+// Which planes a reducer reads. Colour reducers are run on red, green and
+// blue (only red for a grey image); intensity reducers on the intensity
+// plane, with the result written to all three as gray.
+enum planeInput { ColourInput, IntensityInput };
+
+/***************************************************************************//**
+ * PixelTraits
+ *
+ * Author - Dan Andrus
+ *
+ * What a reducer needs to know about a pixel type. A lane holds the sum of up
+ * to lane_taps pixels; for 8-bit pixels that is a 16-bit integer, so twice as
+ * many sums fit in a vector register as with int. A sum holds any weighted
+ * total of lanes. clip brings a result back into the range of the type.
+ ******************************************************************************/
+template <class T>
+struct PixelTraits;
+
+template <>
+struct PixelTraits<uchar>
+{
+  typedef unsigned short lane;          // 257 * 255 still fits
+  typedef int sum;
+  static const int lane_taps = 257;
+  static const int levels = 256;        // Distinct values
+  static uchar clip(sum v) { return v < 0 ? 0 : v > 255 ? 255 : (uchar) v; }
+};
+
+template <>
+struct PixelTraits<unsigned short>
+{
+  typedef unsigned int lane;            // 65537 * 65535 still fits
+  typedef long long sum;
+  static const int lane_taps = 65537;
+  static const int levels = 65536;      // Distinct values
+  static unsigned short clip(sum v) { return v < 0 ? 0 : v > 65535 ? 65535 : (unsigned short) v; }
+};
+
+/***************************************************************************//**
+ * MaskShape
+ *
+ * Author - Dan Andrus
+ *
+ * How far a mask reaches from its center in each direction. From a width and
+ * height, the center is found as in the mask-based filters: for an even size,
+ * the top-left of the center 4.
+ ******************************************************************************/
+struct MaskShape
+{
+  int left;                             // Columns reached left of center
+  int right;                            // Columns reached right of center
+  int top;                              // Rows reached above center
+  int bottom;                           // Rows reached below center
+
+  MaskShape(int mask_w, int mask_h)
+    : left(mask_w / 2 - (1 - mask_w % 2)), right(mask_w - 1 - left),
+      top(mask_h / 2 - (1 - mask_h % 2)), bottom(mask_h - 1 - top) {}
+  MaskShape(int l, int r, int t, int b) : left(l), right(r), top(t), bottom(b) {}
+};
+
+/***************************************************************************//**
+ * Neighborhood
+ *
+ * Author - Dan Andrus
+ *
+ * The pixels under a mask centered on one pixel. at(col, row) is the pixel
+ * under column col and row row of the mask, counting from its top-left, with
+ * pixels past the image edge already replaced by the nearest valid one.
+ ******************************************************************************/
+template <class T>
+struct Neighborhood
+{
+  const T* const* rows;                 // Padded rows under the mask, top first
+  int x;                                // Column of the mask's left edge
+
+  T at(int col, int row) const { return rows[row][x + col]; }
+};
+
+/***************************************************************************//**
+ * PixelReducer
+ *
+ * Author - Dan Andrus
+ *
+ * Base for reducers that work one pixel at a time. The derived struct only
+ * needs an operator() taking a Neighborhood and returning the new value;
+ * reduceRow calls it for each pixel of a row. Reducers that can work on a
+ * whole row at once, and let the compiler vectorize the loads along it,
+ * define their own reduceRow instead.
+ ******************************************************************************/
+template <class Derived, class T = uchar>
+struct PixelReducer
+{
+  void reduceRow(const T* const* rows, int n, T* out)
+  {
+    Derived& self = static_cast<Derived&>(*this);
+    Neighborhood<T> hood;
+
+    hood.rows = rows;
+    for (hood.x = 0; hood.x < n; hood.x++)
+      out[hood.x] = self(hood);
+  }
+};
+
+/***************************************************************************//**
+ * padTile
+ * Author - Dan Andrus
+ *
+ * Copies one rectangle of a plane, and the border a mask reaches around it,
+ * into a buffer of its own. Past the edges of the plane the nearest valid
+ * pixel is repeated, so the reducers never have to clamp. lines receives the
+ * start of each padded row; the rows under the mask centered on row y of the
+ * tile then start at lines[y].
+ *
+ * Parameters -
+ *          plane - the plane to read
+ *          w - columns in the plane
+ *          h - rows in the plane
+ *          tile - the rectangle of the plane to pad
+ *          shape - how far the mask reaches
+ *          padded - receives the padded rectangle
+ *          lines - receives a pointer to each padded row
+ ******************************************************************************/
+template <class T>
+void padTile(const T* plane, int w, int h, const Rect& tile, const MaskShape& shape,
+             vector<T>& padded, vector<const T*>& lines)
+{
+  int pw = tile.w + shape.left + shape.right;  // Width of a padded row
+  int ph = tile.h + shape.top + shape.bottom;  // Number of padded rows
+  int x0 = tile.x - shape.left;         // Column of the first padded pixel
+  int inside0 = max(x0, 0);             // First column inside the plane
+  int inside1 = min(x0 + pw, w);        // One past the last inside
+  int x, y;                             // Temporary variables
+
+  padded.resize((size_t) pw * ph);
+  lines.resize(ph);
+
+  for (y = 0; y < ph; y++)
+  {
+    const T* row = plane + (size_t) min(h - 1, max(0, tile.y - shape.top + y)) * w;
+    T* out = &padded[(size_t) y * pw];
+
+    for (x = x0; x < inside0; x++)
+      out[x - x0] = row[0];
+    std::copy(row + inside0, row + inside1, out + inside0 - x0);
+    for (x = inside1; x < x0 + pw; x++)
+      out[x - x0] = row[w - 1];
+
+    lines[y] = out;
+  }
+}
+
+/***************************************************************************//**
+ * reduceTile
+ * Author - Dan Andrus
+ *
+ * Pads one tile of a plane and runs a reducer over each of its rows.
+ *
+ * Parameters -
+ *          plane - the plane to read
+ *          w - columns in the plane (and in out)
+ *          h - rows in the plane
+ *          tile - the rectangle of the plane to filter
+ *          reducer - computes the output values from the padded rows
+ *          out - receives the filtered tile; same size as plane
+ *          padded, lines - scratch space for padTile
+ ******************************************************************************/
+template <class T, class Reducer>
+void reduceTile(const T* plane, int w, int h, const Rect& tile, Reducer& reducer,
+                T* out, vector<T>& padded, vector<const T*>& lines)
+{
+  padTile(plane, w, h, tile, reducer.shape, padded, lines);
+  for (int y = 0; y < tile.h; y++)
+    reducer.reduceRow(&lines[y], tile.w, out + (size_t) (tile.y + y) * w + tile.x);
+}
+
+/***************************************************************************//**
+ * neighborhoodBand
+ * Author - Dan Andrus
+ *
+ * Runs a reducer over every pixel of a rectangle, on the calling thread. The
+ * rectangle is cut into tiles of columns, each padded once per channel.
+ * Colour reducers must not write over their source, since the border of one
+ * tile is read after the tile next to it has been filtered; intensity
+ * reducers may, since the intensity plane is never written.
+ *
+ * Parameters -
+ *          src - the unpacked image to filter
+ *          dst - receives the filtered pixels; same size as src
+ *          area - the rectangle of src to filter
+ *          reducer - computes one output value from a neighborhood
+ ******************************************************************************/
+template <class Reducer>
+void neighborhoodBand(const ImagePlanes& src, ImagePlanes& dst, const Rect& area,
+                      Reducer reducer)
+{
+  const vector<uchar>* in[3];           // Planes to read
+  vector<uchar>* out[3];                // Planes to write
+  vector<uchar> padded;                 // One channel of the current tile
+  vector<const uchar*> lines;           // Rows of padded
+  int channels;                         // Planes actually filtered
+  int tx, y, c;                         // Temporary variables
+
+  if (area.w <= 0 || area.h <= 0) return;
+
+  if (Reducer::input == IntensityInput)
+  {
+    in[0] = &src.intensity;
+    channels = 1;
+  }
+  else
+  {
+    in[0] = &src.red;
+    in[1] = &src.green;
+    in[2] = &src.blue;
+    channels = src.gray ? 1 : 3;
+  }
+  out[0] = &dst.red;
+  out[1] = &dst.green;
+  out[2] = &dst.blue;
+
+  for (tx = area.x; tx < area.x + area.w; tx += NEIGHBORHOOD_TILE)
+  {
+    Rect tile = makeRect(tx, area.y, min(NEIGHBORHOOD_TILE, area.x + area.w - tx), area.h);
+
+    for (c = 0; c < channels; c++)
+      reduceTile(&(*in[c])[0], src.width, src.height, tile, reducer, &(*out[c])[0],
+                 padded, lines);
+
+    // One filtered plane is copied to the others as gray
+    if (channels == 1)
+    {
+      for (y = 0; y < tile.h; y++)
+      {
+        size_t k = (size_t) (tile.y + y) * dst.width + tile.x;
+        std::copy(&dst.red[k], &dst.red[k] + tile.w, &dst.green[k]);
+        std::copy(&dst.red[k], &dst.red[k] + tile.w, &dst.blue[k]);
+      }
+    }
+  }
+}
+
+/***************************************************************************//**
+ * neighborhoodFilter
+ * Author - Dan Andrus
+ *
+ * Runs a reducer over every pixel of a rectangle, cut into bands of rows
+ * that are spread over all cores. Each band gets its own copy of the
+ * reducer, so reducers may keep scratch space in their members.
+ *
+ * Parameters -
+ *          src - the unpacked image to filter
+ *          dst - receives the filtered pixels; same size as src
+ *          area - the rectangle of src to filter
+ *          reducer - computes one output value from a neighborhood
+ ******************************************************************************/
+template <class Reducer>
+void neighborhoodFilter(const ImagePlanes& src, ImagePlanes& dst, const Rect& area,
+                        const Reducer& reducer)
+{
+  #pragma omp parallel for schedule(dynamic)
+  for (int y = area.y; y < area.y + area.h; y += NEIGHBORHOOD_BAND)
+    neighborhoodBand(src, dst,
+                     makeRect(area.x, y, area.w, min(NEIGHBORHOOD_BAND, area.y + area.h - y)),
+                     reducer);
+
+}
+
+/***************************************************************************//**
+ * neighborhoodPlane
+ * Author - Dan Andrus
+ *
+ * Runs a reducer over every pixel of a rectangle of a single plane of any
+ * pixel type, in bands of rows spread over all cores and tiles of columns
+ * within each band. The reducer must not write over its source.
+ *
+ * Parameters -
+ *          src - the plane to filter
+ *          dst - receives the filtered pixels; same size as src
+ *          w - columns in the plane
+ *          h - rows in the plane
+ *          area - the rectangle of src to filter
+ *          reducer - computes one output value from a neighborhood
+ ******************************************************************************/
+template <class T, class Reducer>
+void neighborhoodPlane(const T* src, T* dst, int w, int h, const Rect& area,
+                       const Reducer& reducer)
+{
+  #pragma omp parallel for schedule(dynamic)
+  for (int y = area.y; y < area.y + area.h; y += NEIGHBORHOOD_BAND)
+  {
+    Reducer local = reducer;            // Scratch space of this band
+    vector<T> padded;                   // One tile, padded
+    vector<const T*> lines;             // Rows of padded
+
+    for (int tx = area.x; tx < area.x + area.w; tx += NEIGHBORHOOD_TILE)
+      reduceTile(src, w, h, makeRect(tx, y, min(NEIGHBORHOOD_TILE, area.x + area.w - tx),
+                                     min(NEIGHBORHOOD_BAND, area.y + area.h - y)),
+                 local, dst, padded, lines);
+  }
+}
+
+/***************************************************************************//**
+ * neighborhoodImage
+ * Author - Dan Andrus
+ *
+ * Runs a reducer over the requested regions of an image. Only the bounding
+ * box of the regions, grown by the reach of the mask, is unpacked, and only
+ * the regions are written back. If a cache key is given, the unpacked pixels
+ * are hashed and the output is kept in the result cache, so running the same
+ * filter on the same pixels again skips the filter.
+ *
+ * Parameters -
+ *          image - the image object to manipulate.
+ *          reducer - computes one output value from a neighborhood
+ *          regions - rectangles to filter; the active regions if not given
+ *          cache_key - names the reducer and its parameters, or null to skip
+ *                      the cache
+ *
+ * Returns
+ *          True if the operation was successful, false if not
+ ******************************************************************************/
+template <class Reducer>
+bool neighborhoodImage(Image& image, const Reducer& reducer, const vector<Rect>* regions = 0,
+                       const char* cache_key = 0)
+{
+  // Make sure image isn't null
+  if (image.IsNull()) return false;
+
+  ImagePlanes planes;                   // The part of the image read
+  ImagePlanes result;                   // The same part after filtering
+  vector<Rect> rects;                   // Regions to filter
+  vector<Rect> local;                   // The regions, relative to box
+  Rect box;                             // Part of the image that is read
+  int halo;                             // How far the mask reaches
+  string key;                           // Names this run for the cache
+  unsigned long long hash = 0;          // Hash of the pixels read
+  size_t r;                             // Temporary variable
+
+  // Only the requested regions are filtered; the rest is left alone
+  rects = imageRegions(image.Width(), image.Height(), regions);
+  if (rects.empty()) return true;
+
+  halo = max(max(reducer.shape.left, reducer.shape.right),
+             max(reducer.shape.top, reducer.shape.bottom));
+  box = padRect(boundingRect(rects), halo, image.Width(), image.Height());
+  if (!unpackRegion(image, box, planes)) return false;
+
+  for (r = 0; r < rects.size(); r++)
+    local.push_back(makeRect(rects[r].x - box.x, rects[r].y - box.y, rects[r].w, rects[r].h));
+
+  // The output only depends on the pixels read, the regions and the reducer
+  if (cache_key)
+  {
+    key = cache_key + regionKey(local);
+    hash = hashPlanes(planes);
+  }
+
+  if (!cache_key || !resultCache().lookup(key, hash, result))
+  {
+    result = planes;
+    for (r = 0; r < rects.size(); r++)
+      neighborhoodFilter(planes, result, local[r], reducer);
+
+    if (cache_key)
+      resultCache().store(key, hash, result);
+  }
+
+  packRegions(result, box.x, box.y, rects, image);
+
+  return true;
+}
@@ -0,0 +1,266 @@
+/***************************************************************************//**
+ * nlmeans.cpp
+ *
+ * Author - Dan Andrus
+ *
+ * Date - October 18, 2026
+ *
+ * Details - Non-local means denoising (Buades, Coll and Morel). Each pixel
+ * becomes a weighted average of the pixels in a search window around it,
+ * weighted by how alike the patches around the two pixels are. Comparing
+ * whole patches for every pair would cost a patch per pixel per offset, so
+ * the distances are found the way Darbon et al. describe: for one offset at
+ * a time, the squared differences between the image and the image moved by
+ * that offset are summed into an integral image, and every patch distance
+ * for that offset is then four lookups.
+ *
+ * The image is split into bands of rows, and each thread takes a band
+ * through every offset, so the accumulated sums only need to be as big as a
+ * band rather than the whole image for each thread.
+ *
+ ******************************************************************************/
+
+#include "nlmeans.h"
+
+// Rows in one band
+static const int NLM_BAND = 32;
+
+// Entries in the table of weights by patch distance
+static const int NLM_TABLE = 4096;
+
+/***************************************************************************//**
+ * NlmSetup
+ *
+ * Author - Dan Andrus
+ *
+ * What every band needs: the channels padded by the search and patch radius,
+ * repeating the border pixels, and the table of weights.
+ ******************************************************************************/
+struct NlmSetup
+{
+  int w, h;                             // Image size
+  int search, patch;                    // Radii of the search window and patch
+  int pad;                              // search + patch
+  int pw;                               // Width of a padded channel
+  int channels;                         // 1 for grey images, 3 for color
+  vector<uchar> padded[3];              // The padded channels
+  vector<float> weight;                 // Weight by scaled patch distance
+  double scale;                         // Patch distance to table index
+};
+
+/***************************************************************************//**
+ * padChannel
+ * Author - Dan Andrus
+ *
+ * Copies a plane into a larger one, repeating the border pixels outward.
+ ******************************************************************************/
+static void padChannel(const vector<uchar>& src, int w, int h, int pad, vector<uchar>& dst)
+{
+  int pw = w + 2 * pad;
+
+  dst.resize((size_t) pw * (h + 2 * pad));
+
+  #pragma omp parallel for
+  for (int y = 0; y < h + 2 * pad; y++)
+  {
+    const uchar* row = &src[(size_t) std::max(0, std::min(h - 1, y - pad)) * w];
+    uchar* out = &dst[(size_t) y * pw];
+
+    for (int x = 0; x < pw; x++)
+      out[x] = row[std::max(0, std::min(w - 1, x - pad))];
+  }
+}
+
+/***************************************************************************//**
+ * denoiseBand
+ * Author - Dan Andrus
+ *
+ * Denoises rows y0 to y1 - 1.
+ *
+ * Parameters -
+ *          s - the padded image and weights
+ *          y0 - first row
+ *          y1 - one past the last row
+ *          out - receives the denoised channels, indexed as in the image
+ ******************************************************************************/
+static void denoiseBand(const NlmSetup& s, int y0, int y1, vector<uchar>* out)
+{
+  int bh = y1 - y0;                     // Rows in the band
+  int p = s.patch;
+  int iw = s.w + 2 * p + 1;             // Integral image width
+  int ih = bh + 2 * p + 1;              // Integral image height
+  vector<long long> integral((size_t) iw * ih, 0);
+  vector<float> total((size_t) bh * s.w, 0.0f);
+  vector<float> sum[3];                 // Weighted sums per channel
+  const uchar* src[3];                  // The padded channels
+  float scale = (float) s.scale;
+  int c;
+
+  for (c = 0; c < s.channels; c++)
+  {
+    sum[c].assign((size_t) bh * s.w, 0.0f);
+    src[c] = &s.padded[c][0];
+  }
+
+  for (int dy = -s.search; dy <= s.search; dy++)
+  {
+    for (int dx = -s.search; dx <= s.search; dx++)
+    {
+      // Integral of the squared differences over the band plus the patch
+      // radius on every side; row and column 0 stay zero
+      for (int i = 0; i < bh + 2 * p; i++)
+      {
+        size_t here = (size_t) (y0 + i - p + s.pad) * s.pw + (s.pad - p);
+        size_t there = here + (long long) dy * s.pw + dx;
+        long long* line = &integral[(size_t) (i + 1) * iw + 1];
+        const long long* above = line - iw;
+        long long run = 0;
+
+        for (int x = 0; x < s.w + 2 * p; x++)
+        {
+          int d = 0;
+          for (c = 0; c < s.channels; c++)
+          {
+            int diff = src[c][here + x] - src[c][there + x];
+            d += diff * diff;
+          }
+          run += d;
+          line[x] = above[x] + run;
+        }
+      }
+
+      // Weigh each pixel's neighbor at this offset by the patch distance
+      for (int i = 0; i < bh; i++)
+      {
+        const long long* top = &integral[(size_t) i * iw];
+        const long long* bottom = &integral[(size_t) (i + 2 * p + 1) * iw];
+        size_t there = (size_t) (y0 + i + dy + s.pad) * s.pw + s.pad + dx;
+        float* tw = &total[(size_t) i * s.w];
+
+        for (int x = 0; x < s.w; x++)
+        {
+          long long dist = bottom[x + 2 * p + 1] - bottom[x] - top[x + 2 * p + 1] + top[x];
+          float index = dist * scale;
+          float wt;
+
+          if (index >= NLM_TABLE) continue;
+          wt = s.weight[(int) index];
+          tw[x] += wt;
+          for (c = 0; c < s.channels; c++)
+            sum[c][(size_t) i * s.w + x] += wt * src[c][there + x];
+        }
+      }
+    }
+  }
+
+  for (c = 0; c < s.channels; c++)
+  {
+    uchar* dst = &out[c][(size_t) y0 * s.w];
+    for (size_t k = 0; k < total.size(); k++)
+      dst[k] = (uchar) std::min(255, (int) (sum[c][k] / total[k] + 0.5f));
+  }
+}
+
+/***************************************************************************//**
+ * nlMeansPlanes
+ * Author - Dan Andrus
+ *
+ * Denoises the red, green and blue planes of an unpacked image. Patches are
+ * compared across all three channels together, so colors stay in step. The
+ * weight of a patch at mean squared distance d2 is
+ *   exp(-max(d2 - 2 sigma^2, 0) / h^2),  h = 0.4 sigma
+ * as Buades et al. suggest for color images; two patches differing only by
+ * noise are about 2 sigma^2 apart.
+ *
+ * Parameters -
+ *          planes - the unpacked image to manipulate
+ *          sigma - standard deviation of the noise, in gray levels
+ *          search - radius of the search window
+ *          patch - radius of the patches compared
+ *
+ * Returns
+ *          True if the operation was successful, false if not
+ ******************************************************************************/
+bool nlMeansPlanes(ImagePlanes& planes, double sigma, int search, int patch)
+{
+  NlmSetup s;
+  vector<uchar>* channels[3] = { &planes.red, &planes.green, &planes.blue };
+  vector<uchar> out[3];
+  double h2, count, cutoff;
+  int c, k;
+
+  if (planes.width == 0 || planes.height == 0 || sigma <= 0 || search < 1 || patch < 0)
+    return false;
+
+  s.w = planes.width;
+  s.h = planes.height;
+  s.search = search;
+  s.patch = patch;
+  s.pad = search + patch;
+  s.pw = s.w + 2 * s.pad;
+  s.channels = planes.gray ? 1 : 3;
+
+  for (c = 0; c < s.channels; c++)
+  {
+    padChannel(*channels[c], s.w, s.h, s.pad, s.padded[c]);
+    out[c].resize(channels[c]->size());
+  }
+
+  // Distances past the point where the weight falls below 1/1000 are dropped
+  h2 = 0.16 * sigma * sigma;
+  count = (2 * patch + 1) * (2 * patch + 1) * s.channels;
+  cutoff = 2 * sigma * sigma + h2 * log(1000.0);
+  s.scale = NLM_TABLE / (cutoff * count);
+  s.weight.resize(NLM_TABLE);
+  for (k = 0; k < NLM_TABLE; k++)
+  {
+    double d2 = (k + 0.5) * cutoff / NLM_TABLE;
+    s.weight[k] = (float) exp(-std::max(d2 - 2 * sigma * sigma, 0.0) / h2);
+  }
+
+  #pragma omp parallel for schedule(dynamic)
+  for (int y0 = 0; y0 < s.h; y0 += NLM_BAND)
+    denoiseBand(s, y0, std::min(s.h, y0 + NLM_BAND), out);
+
+  for (c = 0; c < s.channels; c++)
+    channels[c]->swap(out[c]);
+  if (planes.gray)
+  {
+    planes.green = planes.red;
+    planes.blue = planes.red;
+  }
+
+  return true;
+}
+
+/***************************************************************************//**
+ * nlMeansImage
+ * Author - Dan Andrus
+ *
+ * Denoises the active regions of an image (see nlMeansPlanes). Only the
+ * regions and the search and patch radius around them are read.
+ *
+ * Returns
+ *          True if the operation was successful, false if not
+ ******************************************************************************/
+bool nlMeansImage(Image& image, double sigma, int search, int patch)
+{
+  ImagePlanes planes;                   // The part of the image read
+  vector<Rect> rects;                   // Regions to denoise
+  Rect box;                             // Part of the image that is read
+
+  if (image.IsNull()) return false;
+
+  rects = imageRegions(image.Width(), image.Height());
+  if (rects.empty()) return true;
+
+  box = padRect(boundingRect(rects), search + patch, image.Width(), image.Height());
+  if (!unpackRegion(image, box, planes))
+    return false;
+  if (!nlMeansPlanes(planes, sigma, search, patch))
+    return false;
+
+  packRegions(planes, box.x, box.y, rects, image);
+
+  return true;
+}
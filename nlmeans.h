@@ -0,0 +1,16 @@
+/***************************************************************************//**
+ * nlmeans.h
+ *
+ * Author - Dan Andrus
+ *
+ * Date - October 18, 2026
+ *
+ * Details - Contains the declarations for non-local means denoising.
+ *
+ ******************************************************************************/
+
+#pragma once
+#include "planes.h"
+
+bool nlMeansPlanes(ImagePlanes& planes, double sigma, int search, int patch);
+bool nlMeansImage(Image& image, double sigma, int search, int patch);
@@ -0,0 +1,391 @@
+/***************************************************************************//**
+ * noise.cpp
+ *
+ * Author - Derek Stotz
+ *
+ * Date - October 18, 2026
+ *
+ * Details - Gaussian and impulse noise driven by the Philox4x32-10 counter
+ * based generator. The random numbers for a pixel are a pure function of the
+ * seed and the pixel's position, so rows can be handed to any number of
+ * threads in any order and a given seed always gives the same image. There
+ * is no generator state to share, lock or jump ahead. Normal values come from
+ * the Marsaglia-Tsang ziggurat, which needs one random word and a table
+ * lookup for almost every value instead of a log, a square root and a sine.
+ *
+ ******************************************************************************/
+
+#include "noise.h"
+
+// Philox4x32 round multipliers and Weyl key increments
+static const uint PHILOX_M0 = 0xD2511F53;
+static const uint PHILOX_M1 = 0xCD9E8D57;
+static const uint PHILOX_W0 = 0x9E3779B9;
+static const uint PHILOX_W1 = 0xBB67AE85;
+
+// Separate counter streams, so the two kinds of noise are unrelated
+static const uint GAUSSIAN_STREAM = 0;
+static const uint IMPULSE_STREAM = 1;
+
+/***************************************************************************//**
+ * philox4x32
+ * Author - Derek Stotz
+ *
+ * The Philox4x32-10 generator of Salmon et al. Ten rounds of multiply and
+ * xor turn a 128-bit counter and a 64-bit key into 128 random bits.
+ *
+ * Parameters -
+ *          counter - the four counter words
+ *          key - the two key words
+ *          out - receives four random words
+ ******************************************************************************/
+void philox4x32(const uint counter[4], const uint key[2], uint out[4])
+{
+  uint c0 = counter[0], c1 = counter[1], c2 = counter[2], c3 = counter[3];
+  uint k0 = key[0], k1 = key[1];
+  unsigned long long p0, p1;            // Full products of each round
+
+  for (int round = 0; round < 10; round++)
+  {
+    p0 = (unsigned long long)PHILOX_M0 * c0;
+    p1 = (unsigned long long)PHILOX_M1 * c2;
+
+    c0 = (uint)(p1 >> 32) ^ c1 ^ k0;
+    c1 = (uint)p1;
+    c2 = (uint)(p0 >> 32) ^ c3 ^ k1;
+    c3 = (uint)p0;
+
+    k0 += PHILOX_W0;
+    k1 += PHILOX_W1;
+  }
+
+  out[0] = c0;
+  out[1] = c1;
+  out[2] = c2;
+  out[3] = c3;
+}
+
+// Layers of the ziggurat and the start of its tail
+static const int ZIGGURAT_LAYERS = 128;
+static const double ZIGGURAT_R = 3.442619855899;
+
+/***************************************************************************//**
+ * Ziggurat
+ *
+ * Author - Derek Stotz
+ *
+ * Tables of the 128-layer ziggurat for the normal distribution: k holds the
+ * accept limit of each layer, w the scale from a random word to x, and f the
+ * density at the edge of each layer.
+ ******************************************************************************/
+struct Ziggurat
+{
+  uint k[ZIGGURAT_LAYERS];              // Words below this are accepted at once
+  float w[ZIGGURAT_LAYERS];             // Word to x scale
+  float f[ZIGGURAT_LAYERS];             // exp(-x*x/2) at the layer edge
+
+  Ziggurat();
+};
+
+/***************************************************************************//**
+ * Ziggurat::Ziggurat
+ * Author - Derek Stotz
+ *
+ * Builds the tables, following Marsaglia and Tsang (2000).
+ ******************************************************************************/
+Ziggurat::Ziggurat()
+{
+  const double m = 2147483648.0;        // 2^31, the scale of a signed word
+  const double v = 9.91256303526217e-3; // Area of each layer
+  double d = ZIGGURAT_R;                // Edge of the current layer
+  double t = d;                         // Edge of the layer above
+  double q = v / exp(-0.5 * d * d);
+
+  k[0] = (uint)((d / q) * m);
+  k[1] = 0;
+  w[0] = (float)(q / m);
+  w[ZIGGURAT_LAYERS - 1] = (float)(d / m);
+  f[0] = 1.0f;
+  f[ZIGGURAT_LAYERS - 1] = (float)exp(-0.5 * d * d);
+
+  for (int i = ZIGGURAT_LAYERS - 2; i >= 1; i--)
+  {
+    d = sqrt(-2.0 * log(v / d + exp(-0.5 * d * d)));
+    k[i + 1] = (uint)((d / t) * m);
+    t = d;
+    f[i] = (float)exp(-0.5 * d * d);
+    w[i] = (float)(d / m);
+  }
+}
+
+/***************************************************************************//**
+ * PixelStream
+ *
+ * Author - Derek Stotz
+ *
+ * The random words belonging to one pixel of one noise stream. The first
+ * four come from a single Philox call; in the rare case more are needed the
+ * last counter word is stepped to get four more.
+ ******************************************************************************/
+class PixelStream
+{
+  public:
+    PixelStream(uint seed, uint stream, long long index);
+    uint next();
+    float uniform();
+    float normal();
+
+  private:
+    void refill();
+
+    uint counter[4];                    // Stream, pixel and refill number
+    uint key[2];                        // Seed
+    uint words[4];                      // Current block of random words
+    int used;                           // Words of the block handed out
+};
+
+/***************************************************************************//**
+ * PixelStream::PixelStream
+ * Author - Derek Stotz
+ *
+ * Parameters -
+ *          seed - the user's seed
+ *          stream - which kind of noise the words are for
+ *          index - row-major position of the pixel
+ ******************************************************************************/
+PixelStream::PixelStream(uint seed, uint stream, long long index)
+{
+  counter[0] = (uint)index;
+  counter[1] = (uint)(index >> 32);
+  counter[2] = stream;
+  counter[3] = 0;
+  key[0] = seed;
+  key[1] = 0x5EED5EED;
+  refill();
+}
+
+/***************************************************************************//**
+ * PixelStream::refill
+ * Author - Derek Stotz
+ *
+ * Draws the next block of four words.
+ ******************************************************************************/
+void PixelStream::refill()
+{
+  philox4x32(counter, key, words);
+  counter[3]++;
+  used = 0;
+}
+
+/***************************************************************************//**
+ * PixelStream::next
+ * Author - Derek Stotz
+ *
+ * Returns
+ *          The next random word of the pixel
+ ******************************************************************************/
+inline uint PixelStream::next()
+{
+  if (used == 4) refill();
+  return words[used++];
+}
+
+/***************************************************************************//**
+ * PixelStream::uniform
+ * Author - Derek Stotz
+ *
+ * Returns
+ *          A float strictly between 0 and 1, so its log is always finite
+ ******************************************************************************/
+inline float PixelStream::uniform()
+{
+  return ((next() >> 8) + 0.5f) * (1.0f / 16777216.0f);
+}
+
+/***************************************************************************//**
+ * PixelStream::normal
+ * Author - Derek Stotz
+ *
+ * Draws a value from the standard normal distribution with the ziggurat.
+ * About 99 draws in 100 are settled by the first compare.
+ *
+ * Returns
+ *          A normal value with mean 0 and standard deviation 1
+ ******************************************************************************/
+float PixelStream::normal()
+{
+  static const Ziggurat zig;            // Built once, on first use
+  int hz;                               // Random word as a signed number
+  int iz;                               // Layer picked by the word
+  uint mag;                             // Size of hz
+  float x, y;                           // Candidate value and test height
+
+  for (;;)
+  {
+    hz = (int)next();
+    iz = hz & (ZIGGURAT_LAYERS - 1);
+    mag = hz < 0 ? 0u - (uint)hz : (uint)hz;
+    x = hz * zig.w[iz];
+
+    // Inside the rectangle of the layer
+    if (mag < zig.k[iz])
+      return x;
+
+    // In the tail past the last layer
+    if (iz == 0)
+    {
+      do
+      {
+        x = -logf(uniform()) * (float)(1.0 / ZIGGURAT_R);
+        y = -logf(uniform());
+      } while (y + y < x * x);
+
+      return hz > 0 ? (float)ZIGGURAT_R + x : -(float)ZIGGURAT_R - x;
+    }
+
+    // In the wedge between the rectangle and the curve
+    if (zig.f[iz] + uniform() * (zig.f[iz - 1] - zig.f[iz]) < expf(-0.5f * x * x))
+      return x;
+  }
+}
+
+/***************************************************************************//**
+ * addClipped
+ * Author - Derek Stotz
+ *
+ * Adds rounded noise to a channel value, clipping to the valid range.
+ ******************************************************************************/
+static inline uchar addClipped(uchar value, float noise)
+{
+  int v = value + (int)lrintf(noise);
+
+  if (v < 0)     v = 0;
+  if (v >= 256)  v = 256-1;
+  return (uchar)v;
+}
+
+/***************************************************************************//**
+ * gaussianNoisePlanes
+ * Author - Derek Stotz
+ *
+ * Adds independent zero-mean Gaussian noise to the red, green and blue value
+ * of every pixel. The intensity plane is not updated.
+ *
+ * Parameters -
+ *          planes - the unpacked image to add noise to
+ *          stddev - standard deviation of the noise, in gray levels
+ *          seed - picks the noise; the same seed always gives the same noise
+ ******************************************************************************/
+void gaussianNoisePlanes(ImagePlanes& planes, double stddev, uint seed)
+{
+  const float scale = (float)stddev;
+  const int w = planes.width;
+
+  #pragma omp parallel for
+  for (int i = 0; i < planes.height; i++)
+  {
+    long long k = (long long)i * w;
+
+    for (int j = 0; j < w; j++, k++)
+    {
+      PixelStream random(seed, GAUSSIAN_STREAM, k);
+
+      planes.red[k] = addClipped(planes.red[k], scale * random.normal());
+      planes.green[k] = addClipped(planes.green[k], scale * random.normal());
+      planes.blue[k] = addClipped(planes.blue[k], scale * random.normal());
+    }
+  }
+
+  planes.gray = false;
+}
+
+/***************************************************************************//**
+ * impulseNoisePlanes
+ * Author - Derek Stotz
+ *
+ * Turns a random selection of pixels pure white or pure black, each with
+ * equal chance. The intensity plane is not updated.
+ *
+ * Parameters -
+ *          planes - the unpacked image to add noise to
+ *          probability - chance of any one pixel being hit, from 0 to 1
+ *          seed - picks the noise; the same seed always gives the same noise
+ ******************************************************************************/
+void impulseNoisePlanes(ImagePlanes& planes, double probability, uint seed)
+{
+  const int w = planes.width;
+  unsigned long long limit;             // Words below this hit the pixel
+
+  if (probability <= 0) return;
+  if (probability > 1) probability = 1;
+  limit = (unsigned long long)(probability * 4294967296.0);
+
+  #pragma omp parallel for
+  for (int i = 0; i < planes.height; i++)
+  {
+    uchar val;                          // Salt or pepper
+    long long k = (long long)i * w;
+
+    for (int j = 0; j < w; j++, k++)
+    {
+      PixelStream random(seed, IMPULSE_STREAM, k);
+      if (random.next() >= limit) continue;
+
+      val = (random.next() & 1) ? 256-1 : 0;
+      planes.red[k] = val;
+      planes.green[k] = val;
+      planes.blue[k] = val;
+    }
+  }
+
+}
+
+/***************************************************************************//**
+ * addGaussianNoise
+ * Author - Derek Stotz
+ *
+ * Adds seeded Gaussian noise to an image (see gaussianNoisePlanes).
+ *
+ * Parameters -
+ *          image - the image object to manipulate.
+ *          stddev - standard deviation of the noise, in gray levels
+ *          seed - picks the noise; the same seed always gives the same noise
+ *
+ * Returns
+ *          True if the operation was successful, false if not
+ ******************************************************************************/
+bool addGaussianNoise(Image& image, double stddev, uint seed)
+{
+  ImagePlanes planes;
+
+  if (stddev < 0 || !unpackImage(image, planes)) return false;
+
+  gaussianNoisePlanes(planes, stddev, seed);
+  packImage(planes, image);
+  return true;
+}
+
+/***************************************************************************//**
+ * addImpulseNoise
+ * Author - Derek Stotz
+ *
+ * Adds seeded salt and pepper noise to an image (see impulseNoisePlanes).
+ *
+ * Parameters -
+ *          image - the image object to manipulate.
+ *          probability - chance of any one pixel being hit, from 0 to 1
+ *          seed - picks the noise; the same seed always gives the same noise
+ *
+ * Returns
+ *          True if the operation was successful, false if not
+ ******************************************************************************/
+bool addImpulseNoise(Image& image, double probability, uint seed)
+{
+  ImagePlanes planes;
+
+  if (!unpackImage(image, planes)) return false;
+
+  impulseNoisePlanes(planes, probability, seed);
+  packImage(planes, image);
+  return true;
+}
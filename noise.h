@@ -0,0 +1,20 @@
+/***************************************************************************//**
+ * noise.h
+ *
+ * Author - Derek Stotz
+ *
+ * Date - October 18, 2026
+ *
+ * Details - Contains the declarations for the seeded, counter-based noise
+ * generators.
+ *
+ ******************************************************************************/
+
+#pragma once
+#include "planes.h"
+
+void philox4x32(const uint counter[4], const uint key[2], uint out[4]);
+void gaussianNoisePlanes(ImagePlanes& planes, double stddev, uint seed);
+void impulseNoisePlanes(ImagePlanes& planes, double probability, uint seed);
+bool addGaussianNoise(Image& image, double stddev, uint seed);
+bool addImpulseNoise(Image& image, double probability, uint seed);
@@ -0,0 +1,178 @@
+/***************************************************************************//**
+ * planes.cpp
+ *
+ * Author - Dan Andrus
+ *
+ * Date - October 18, 2026
+ *
+ * Details - Conversion between QtImageLib images and planar 8-bit buffers.
+ *
+ ******************************************************************************/
+
+#include "planes.h"
+
+/***************************************************************************//**
+ * unpackImage
+ * Author - Dan Andrus
+ *
+ * Copies every pixel of an image into a set of planar buffers. The intensity
+ * plane is taken straight from Pixel::Intensity() so that anything computed
+ * from it matches what the QtImageLib functions would see. Whether the image
+ * is grey is noted along the way.
+ *
+ * Parameters -
+ *          image - the image to read from
+ *          planes - receives the planar copy of the image
+ *
+ * Returns
+ *          True if the operation was successful, false if the image is null
+ ******************************************************************************/
+bool unpackImage(Image& image, ImagePlanes& planes)
+{
+  // Make sure image isn't null
+  if (image.IsNull()) return false;
+
+  int i, j, k;                          // Temporary variables
+  bool gray = true;                     // No pixel with colour seen yet
+
+  planes.width = image.Width();
+  planes.height = image.Height();
+
+  planes.red.resize(planes.width * planes.height);
+  planes.green.resize(planes.width * planes.height);
+  planes.blue.resize(planes.width * planes.height);
+  planes.intensity.resize(planes.width * planes.height);
+
+  for (i = 0, k = 0; i < planes.height; ++i)
+  {
+    for (j = 0; j < planes.width; ++j, ++k)
+    {
+      planes.red[k] = image[i][j].Red();
+      planes.green[k] = image[i][j].Green();
+      planes.blue[k] = image[i][j].Blue();
+      planes.intensity[k] = image[i][j].Intensity();
+      gray = gray && planes.red[k] == planes.green[k] && planes.green[k] == planes.blue[k];
+    }
+  }
+
+  planes.gray = gray;
+
+  return true;
+}
+
+/***************************************************************************//**
+ * packImage
+ * Author - Dan Andrus
+ *
+ * Writes the red, green and blue planes back into an image of the same size.
+ * The intensity plane is ignored; the image recomputes it from RGB.
+ *
+ * Parameters -
+ *          planes - the planar buffers to copy from
+ *          image - the image to write into
+ ******************************************************************************/
+void packImage(const ImagePlanes& planes, Image& image)
+{
+  int i, j, k;                          // Temporary variables
+
+  for (i = 0, k = 0; i < planes.height; ++i)
+    for (j = 0; j < planes.width; ++j, ++k)
+      image[i][j].SetRGB(planes.red[k], planes.green[k], planes.blue[k]);
+}
+
+/***************************************************************************//**
+ * unpackRegion
+ * Author - Dan Andrus
+ *
+ * Copies one rectangle of an image into a set of planar buffers the size of
+ * the rectangle, so a filter restricted to a region only reads what it needs.
+ *
+ * Parameters -
+ *          image - the image to read from
+ *          area - the rectangle to copy; must lie inside the image
+ *          planes - receives the planar copy of the rectangle
+ *
+ * Returns
+ *          True if the operation was successful, false if there is nothing
+ *          to copy
+ ******************************************************************************/
+bool unpackRegion(Image& image, const Rect& area, ImagePlanes& planes)
+{
+  // Make sure there is something to read
+  if (image.IsNull() || emptyRect(area)) return false;
+
+  int i, j, k;                          // Temporary variables
+  bool gray = true;                     // No pixel with colour seen yet
+
+  planes.width = area.w;
+  planes.height = area.h;
+
+  planes.red.resize(area.w * area.h);
+  planes.green.resize(area.w * area.h);
+  planes.blue.resize(area.w * area.h);
+  planes.intensity.resize(area.w * area.h);
+
+  for (i = 0, k = 0; i < area.h; ++i)
+  {
+    for (j = 0; j < area.w; ++j, ++k)
+    {
+      planes.red[k] = image[area.y + i][area.x + j].Red();
+      planes.green[k] = image[area.y + i][area.x + j].Green();
+      planes.blue[k] = image[area.y + i][area.x + j].Blue();
+      planes.intensity[k] = image[area.y + i][area.x + j].Intensity();
+      gray = gray && planes.red[k] == planes.green[k] && planes.green[k] == planes.blue[k];
+    }
+  }
+
+  planes.gray = gray;
+
+  return true;
+}
+
+/***************************************************************************//**
+ * packRegion
+ * Author - Dan Andrus
+ *
+ * Writes one rectangle of a set of planes back into an image. The planes may
+ * cover only part of the image, starting at column x0 and row y0.
+ *
+ * Parameters -
+ *          planes - the planar buffers to copy from
+ *          x0, y0 - image position of the first pixel of the planes
+ *          area - the rectangle to write, in image coordinates
+ *          image - the image to write into
+ ******************************************************************************/
+void packRegion(const ImagePlanes& planes, int x0, int y0, const Rect& area, Image& image)
+{
+  int i, j, k;                          // Temporary variables
+
+  for (i = area.y; i < area.y + area.h; ++i)
+  {
+    for (j = area.x; j < area.x + area.w; ++j)
+    {
+      k = (i - y0) * planes.width + (j - x0);
+      image[i][j].SetRGB(planes.red[k], planes.green[k], planes.blue[k]);
+    }
+  }
+}
+
+/***************************************************************************//**
+ * packRegions
+ * Author - Dan Andrus
+ *
+ * Writes several rectangles of a set of planes back into an image (see
+ * packRegion). Filters pass the rectangles from imageRegions so that only the
+ * active regions change.
+ *
+ * Parameters -
+ *          planes - the planar buffers to copy from
+ *          x0, y0 - image position of the first pixel of the planes
+ *          areas - the rectangles to write, in image coordinates
+ *          image - the image to write into
+ ******************************************************************************/
+void packRegions(const ImagePlanes& planes, int x0, int y0, const vector<Rect>& areas,
+                 Image& image)
+{
+  for (size_t r = 0; r < areas.size(); r++)
+    packRegion(planes, x0, y0, areas[r], image);
+}
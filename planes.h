@@ -0,0 +1,50 @@
+/***************************************************************************//**
+ * planes.h
+ *
+ * Author - Dan Andrus
+ *
+ * Date - October 18, 2026
+ *
+ * Details - Contains the declaration for the ImagePlanes structure, a planar
+ * 8-bit copy of a QtImageLib image that the faster filters work on directly.
+ *
+ ******************************************************************************/
+
+#pragma once
+#include "toolbox.h"
+#include "region.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/***************************************************************************//**
+ * ImagePlanes
+ *
+ * Author - Dan Andrus
+ *
+ * Holds the red, green, blue and intensity values of an image as four
+ * contiguous row-major planes. QtImageLib pixels can only be reached one at a
+ * time through Image::operator[], so the heavier processes unpack the image
+ * once, work on these plain arrays (in parallel where they can), and pack the
+ * result back. Anything that can give a grey image colour must clear gray.
+ ******************************************************************************/
+struct ImagePlanes
+{
+  int width;                            // Columns in each plane
+  int height;                           // Rows in each plane
+  vector<uchar> red;                    // Red channel
+  vector<uchar> green;                  // Green channel
+  vector<uchar> blue;                   // Blue channel
+  vector<uchar> intensity;              // Pixel::Intensity() of each pixel
+  bool gray;                            // Red, green and blue all equal
+
+  ImagePlanes() : width(0), height(0), gray(false) {}
+};
+
+bool unpackImage(Image& image, ImagePlanes& planes);
+void packImage(const ImagePlanes& planes, Image& image);
+bool unpackRegion(Image& image, const Rect& area, ImagePlanes& planes);
+void packRegion(const ImagePlanes& planes, int x0, int y0, const Rect& area, Image& image);
+void packRegions(const ImagePlanes& planes, int x0, int y0, const vector<Rect>& areas,
+                 Image& image);
@@ -0,0 +1,188 @@
+/***************************************************************************//**
+ * preview.cpp
+ *
+ * Author - Derek Stotz
+ *
+ * Date - October 18, 2026
+ *
+ * Details - Support for previewing slow filters on a low-resolution proxy
+ * while the full-resolution render runs in the background.
+ *
+ ******************************************************************************/
+
+#include "preview.h"
+
+// Rows the worker filters between checks of the cancel flag
+static const int RENDER_BAND = 16;
+
+/***************************************************************************//**
+ * BackgroundRender::BackgroundRender
+ * Author - Derek Stotz
+ *
+ * Creates an idle background render.
+ ******************************************************************************/
+BackgroundRender::BackgroundRender()
+  : cancelled(false), finished(false), filter(0), width(0)
+{
+}
+
+/***************************************************************************//**
+ * BackgroundRender::~BackgroundRender
+ * Author - Derek Stotz
+ *
+ * Stops any render still running and waits for it, since it writes into this
+ * object.
+ ******************************************************************************/
+BackgroundRender::~BackgroundRender()
+{
+  if (worker.joinable())
+  {
+    cancel();
+    worker.join();
+  }
+}
+
+/***************************************************************************//**
+ * BackgroundRender::run
+ * Author - Derek Stotz
+ *
+ * Body of the worker thread. Bands are handed out to the OpenMP threads one
+ * at a time, each checking the cancel flag before it starts.
+ *
+ * Parameters -
+ *          job - the render to carry out
+ ******************************************************************************/
+void BackgroundRender::run(BackgroundRender* job)
+{
+  int h = job->source.height;           // Rows to render
+
+  #pragma omp parallel for schedule(dynamic)
+  for (int i = 0; i < h; i += RENDER_BAND)
+  {
+    if (job->cancelled.load(std::memory_order_relaxed)) continue;
+
+    job->filter(job->source, job->output,
+                makeRect(0, i, job->source.width, std::min(RENDER_BAND, h - i)), job->width);
+  }
+
+  job->finished.store(true);
+}
+
+/***************************************************************************//**
+ * BackgroundRender::start
+ * Author - Derek Stotz
+ *
+ * Starts rendering a filtered copy of an image. Any earlier render is
+ * cancelled, so this only waits for the bands it has already started.
+ *
+ * Parameters -
+ *          src - the unpacked image to filter; copied, so it may go away
+ *          f - the filter to run
+ *          mask_w - the filter width to run it with
+ ******************************************************************************/
+void BackgroundRender::start(const ImagePlanes& src, bandFilter f, int mask_w)
+{
+  if (worker.joinable())
+  {
+    cancel();
+    worker.join();
+  }
+
+  source = src;
+  output = src;
+  filter = f;
+  width = mask_w;
+  cancelled.store(false);
+  finished.store(false);
+  worker = std::thread(run, this);
+}
+
+/***************************************************************************//**
+ * BackgroundRender::cancel
+ * Author - Derek Stotz
+ *
+ * Asks the render to stop. Bands already started are allowed to finish, and
+ * finish() then reports that there is no result.
+ ******************************************************************************/
+void BackgroundRender::cancel()
+{
+  cancelled.store(true);
+}
+
+/***************************************************************************//**
+ * BackgroundRender::active
+ * Author - Derek Stotz
+ *
+ * Returns
+ *          True if a render was started and its result not yet collected
+ ******************************************************************************/
+bool BackgroundRender::active() const
+{
+  return worker.joinable();
+}
+
+/***************************************************************************//**
+ * BackgroundRender::done
+ * Author - Derek Stotz
+ *
+ * Returns
+ *          True if the render has finished and finish() will not block
+ ******************************************************************************/
+bool BackgroundRender::done() const
+{
+  return finished.load();
+}
+
+/***************************************************************************//**
+ * BackgroundRender::finish
+ * Author - Derek Stotz
+ *
+ * Waits for the render to finish and hands over its result.
+ *
+ * Parameters -
+ *          result - receives the filtered image
+ *
+ * Returns
+ *          True if there was a render and it ran to the end, false if not
+ ******************************************************************************/
+bool BackgroundRender::finish(ImagePlanes& result)
+{
+  if (!worker.joinable()) return false;
+
+  worker.join();
+  if (cancelled.load() || source.width * source.height == 0) return false;
+
+  result = output;
+  output = ImagePlanes();
+  source = ImagePlanes();
+  return true;
+}
+
+/***************************************************************************//**
+ * proxyLevel
+ * Author - Derek Stotz
+ *
+ * Picks the finest pyramid level whose size is no more than a given number of
+ * pixels, which is what a preview should be rendered at.
+ *
+ * Parameters -
+ *          width - columns in the full-size image
+ *          height - rows in the full-size image
+ *          max_pixels - the most pixels a proxy may have
+ *
+ * Returns
+ *          The pyramid level to render the proxy at, 0 being full size
+ ******************************************************************************/
+int proxyLevel(int width, int height, int max_pixels)
+{
+  int level = 0;
+
+  while ((long long) width * height > max_pixels && width > 1 && height > 1)
+  {
+    width = (width + 1) / 2;
+    height = (height + 1) / 2;
+    level++;
+  }
+
+  return level;
+}
@@ -0,0 +1,57 @@
+/***************************************************************************//**
+ * preview.h
+ *
+ * Author - Derek Stotz
+ *
+ * Date - October 18, 2026
+ *
+ * Details - Contains the declaration for the BackgroundRender class and the
+ * proxy preview helpers.
+ *
+ ******************************************************************************/
+
+#pragma once
+#include "planes.h"
+#include <thread>
+#include <atomic>
+
+// Renders one rectangle of src into dst, a copy of src, with the given filter width
+typedef void (*bandFilter)(const ImagePlanes& src, ImagePlanes& dst, const Rect& area,
+                           int mask_w);
+
+/***************************************************************************//**
+ * BackgroundRender
+ *
+ * Author - Derek Stotz
+ *
+ * Runs a filter over a private copy of an image on a worker thread, so the
+ * GUI can go on showing a preview while the full-resolution result is made.
+ * The image is filtered in bands of rows, and a cancel flag is checked before
+ * each band, so a render that is no longer wanted stops within one band
+ * instead of holding up the GUI thread. The worker never touches a QtImageLib
+ * image.
+ ******************************************************************************/
+class BackgroundRender
+{
+  public:
+    BackgroundRender();
+    ~BackgroundRender();
+    void start(const ImagePlanes& src, bandFilter filter, int mask_w);
+    void cancel();
+    bool active() const;
+    bool done() const;
+    bool finish(ImagePlanes& result);
+
+  private:
+    static void run(BackgroundRender* job);
+
+    std::thread worker;                 // Thread doing the render
+    std::atomic<bool> cancelled;        // Set to stop at the next band
+    std::atomic<bool> finished;         // Set by the worker when it is done
+    ImagePlanes source;                 // Private copy of the input
+    ImagePlanes output;                 // Where the worker writes
+    bandFilter filter;                  // The filter being run
+    int width;                          // Its filter width
+};
+
+int proxyLevel(int width, int height, int max_pixels);
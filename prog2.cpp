@@ -62,6 +62,14 @@ Details - The purpose of this assignment was to implement most of the neighborho
 #include "PointProcessor.h"
 #include "EdgeDetectionMenu.cpp"
 #include "SmoothingMenu.h"
+#include "PyramidMenu.h"
+#include "HistoryMenu.h"
+#include "RegionMenu.h"
+#include "CacheMenu.h"
+#include "MorphologyMenu.h"
+#include "BinaryMenu.h"
+#include "TuningMenu.h"
+#include "HighBitDepthMenu.h"
 
 /***************************************************************************//**
  * main
@@ -83,6 +91,14 @@ int main(int argc, char** argv)
   PointProcessor ilp;
   EdgeDetectionMenu edm;
   SmoothingMenu sm;
+  PyramidMenu pm;
+  HistoryMenu hm;
+  RegionMenu rm;
+  CacheMenu cm;
+  MorphologyMenu mm;
+  BinaryMenu bm;
+  TuningMenu tm;
+  HighBitDepthMenu hbm;
 
   ImageApp app(argc, argv);
 
@@ -91,6 +107,14 @@ int main(int argc, char** argv)
   app.AddActions(&ilp);
   app.AddActions(&edm);\
   app.AddActions(&sm);
+  app.AddActions(&pm);
+  app.AddActions(&hm);
+  app.AddActions(&rm);
+  app.AddActions(&cm);
+  app.AddActions(&mm);
+  app.AddActions(&bm);
+  app.AddActions(&tm);
+  app.AddActions(&hbm);
   return app.Start();
 }
 
@@ -4,13 +4,84 @@ HEADERS += \
     RankOrderFilterMenu.h \
     toolbox.h \
     EdgeDetectionMenu.h \
-    SmoothingMenu.h
+    SmoothingMenu.h \
+    planes.h \
+    histogram.h \
+    lut.h \
+    imagestats.h \
+    gaussian.h \
+    pyramid.h \
+    PyramidMenu.h \
+    rankorder.h \
+    preview.h \
+    asyncfilter.h \
+    tiledimage.h \
+    HistoryMenu.h \
+    region.h \
+    RegionMenu.h \
+    noise.h \
+    resultcache.h \
+    CacheMenu.h \
+    morphology.h \
+    MorphologyMenu.h \
+    binaryimage.h \
+    BinaryMenu.h \
+    canny.h \
+    bilateral.h \
+    guided.h \
+    nlmeans.h \
+    clahe.h \
+    components.h \
+    distance.h \
+    autotune.h \
+    TuningMenu.h \
+    sparsemask.h \
+    neighborhood.h \
+    deepimage.h \
+    HighBitDepthMenu.h
 SOURCES += prog2.cpp \
     PointProcessor.cpp \
     NoiseToolMenu.cpp \
     RankOrderFilterMenu.cpp \
     toolbox.cpp \
     EdgeDetectionMenu.cpp \
-    SmoothingMenu.cpp
-CONFIG += qtimagelib
+    SmoothingMenu.cpp \
+    planes.cpp \
+    histogram.cpp \
+    lut.cpp \
+    imagestats.cpp \
+    gaussian.cpp \
+    pyramid.cpp \
+    PyramidMenu.cpp \
+    rankorder.cpp \
+    preview.cpp \
+    asyncfilter.cpp \
+    tiledimage.cpp \
+    HistoryMenu.cpp \
+    region.cpp \
+    RegionMenu.cpp \
+    noise.cpp \
+    resultcache.cpp \
+    CacheMenu.cpp \
+    morphology.cpp \
+    MorphologyMenu.cpp \
+    binaryimage.cpp \
+    BinaryMenu.cpp \
+    canny.cpp \
+    bilateral.cpp \
+    guided.cpp \
+    nlmeans.cpp \
+    clahe.cpp \
+    components.cpp \
+    distance.cpp \
+    autotune.cpp \
+    TuningMenu.cpp \
+    sparsemask.cpp \
+    deepimage.cpp \
+    HighBitDepthMenu.cpp
+CONFIG += qtimagelib c++11
+
+# The planar pixel loops are spread over all cores with OpenMP
+QMAKE_CXXFLAGS += -fopenmp
+QMAKE_LFLAGS += -fopenmp
 
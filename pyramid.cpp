@@ -0,0 +1,389 @@
+/***************************************************************************//**
+ * pyramid.cpp
+ *
+ * Author - Dan Andrus
+ *
+ * Date - October 18, 2026
+ *
+ * Details - Gaussian and Laplacian image pyramids built with the separable
+ * 1-4-6-4-1 kernel. Running a filter on level k touches roughly 1/4^k of the
+ * pixels it would at full resolution.
+ *
+ ******************************************************************************/
+
+#include "pyramid.h"
+#include <cstring>
+
+/***************************************************************************//**
+ * reducePlane
+ * Author - Dan Andrus
+ *
+ * Blurs one plane with the 5-tap kernel and keeps every other row and column.
+ * Borders repeat the nearest pixel.
+ *
+ * Parameters -
+ *          src - the plane to reduce
+ *          w - columns in src
+ *          h - rows in src
+ *          dst - receives the (w+1)/2 by (h+1)/2 result
+ ******************************************************************************/
+static void reducePlane(const uchar* src, int w, int h, uchar* dst)
+{
+  const int taps[5] = { 1, 4, 6, 4, 1 };
+  int dw = (w + 1) / 2;                 // Columns in the result
+  int dh = (h + 1) / 2;                 // Rows in the result
+  vector<int> rows(dw * h);             // Horizontally reduced rows
+
+  // Horizontal pass over every source row
+  #pragma omp parallel for
+  for (int i = 0; i < h; i++)
+  {
+    for (int j = 0; j < dw; j++)
+    {
+      int sum = 0;
+      for (int k = -2; k <= 2; k++)
+      {
+        int x = std::max(0, std::min(w - 1, 2 * j + k));
+        sum += taps[k + 2] * src[i * w + x];
+      }
+      rows[i * dw + j] = sum;
+    }
+  }
+
+  // Vertical pass keeping every other row; the kernel sums to 16 x 16
+  #pragma omp parallel for
+  for (int i = 0; i < dh; i++)
+  {
+    for (int j = 0; j < dw; j++)
+    {
+      int sum = 0;
+      for (int k = -2; k <= 2; k++)
+      {
+        int y = std::max(0, std::min(h - 1, 2 * i + k));
+        sum += taps[k + 2] * rows[y * dw + j];
+      }
+      dst[i * dw + j] = (uchar) ((sum + 128) >> 8);
+    }
+  }
+}
+
+/***************************************************************************//**
+ * expandPlane
+ * Author - Dan Andrus
+ *
+ * Doubles the size of one plane, interpolating with the same 5-tap kernel
+ * used to reduce it: even output samples weigh their three nearest inputs
+ * 1-6-1, odd ones the two neighbours equally.
+ *
+ * Parameters -
+ *          src - the plane to expand
+ *          sw - columns in src
+ *          sh - rows in src
+ *          dst - receives the result
+ *          w - columns in dst, at most 2 * sw
+ *          h - rows in dst, at most 2 * sh
+ ******************************************************************************/
+static void expandPlane(const uchar* src, int sw, int sh, uchar* dst, int w, int h)
+{
+  vector<int> rows(w * sh);             // Horizontally expanded rows
+
+  #pragma omp parallel for
+  for (int i = 0; i < sh; i++)
+  {
+    const uchar* row = src + i * sw;
+    for (int j = 0; j < w; j++)
+    {
+      int c = j / 2;
+      int l = std::max(0, c - 1);
+      int r = std::min(sw - 1, c + 1);
+      if (j % 2 == 0)
+        rows[i * w + j] = row[l] + 6 * row[c] + row[r];
+      else
+        rows[i * w + j] = 4 * row[c] + 4 * row[r];
+    }
+  }
+
+  // Vertical pass; both passes together scale by 8 x 8
+  #pragma omp parallel for
+  for (int i = 0; i < h; i++)
+  {
+    int c = i / 2;
+    int u = std::max(0, c - 1);
+    int d = std::min(sh - 1, c + 1);
+    for (int j = 0; j < w; j++)
+    {
+      int sum;
+      if (i % 2 == 0)
+        sum = rows[u * w + j] + 6 * rows[c * w + j] + rows[d * w + j];
+      else
+        sum = 4 * rows[c * w + j] + 4 * rows[d * w + j];
+      dst[i * w + j] = (uchar) std::min(255, (sum + 32) >> 6);
+    }
+  }
+}
+
+/***************************************************************************//**
+ * pyramidReduce
+ * Author - Dan Andrus
+ *
+ * Builds the next coarser pyramid level of an unpacked image.
+ *
+ * Parameters -
+ *          src - the level to reduce
+ *          dst - receives the half-size level
+ *
+ * Returns
+ *          True if the operation was successful, false if src is too small
+ ******************************************************************************/
+bool pyramidReduce(const ImagePlanes& src, ImagePlanes& dst)
+{
+  if (src.width < 2 || src.height < 2) return false;
+
+  dst.width = (src.width + 1) / 2;
+  dst.height = (src.height + 1) / 2;
+  dst.red.resize(dst.width * dst.height);
+  dst.green.resize(dst.width * dst.height);
+  dst.blue.resize(dst.width * dst.height);
+  dst.intensity.resize(dst.width * dst.height);
+  dst.gray = src.gray;
+
+  reducePlane(&src.red[0], src.width, src.height, &dst.red[0]);
+  reducePlane(&src.green[0], src.width, src.height, &dst.green[0]);
+  reducePlane(&src.blue[0], src.width, src.height, &dst.blue[0]);
+  reducePlane(&src.intensity[0], src.width, src.height, &dst.intensity[0]);
+
+  return true;
+}
+
+/***************************************************************************//**
+ * pyramidExpand
+ * Author - Dan Andrus
+ *
+ * Expands a pyramid level to the next finer size.
+ *
+ * Parameters -
+ *          src - the level to expand
+ *          w - columns wanted, at most twice those of src
+ *          h - rows wanted, at most twice those of src
+ *          dst - receives the expanded level
+ *
+ * Returns
+ *          True if the operation was successful, false if not
+ ******************************************************************************/
+bool pyramidExpand(const ImagePlanes& src, int w, int h, ImagePlanes& dst)
+{
+  if (src.width < 1 || src.height < 1 || w > 2 * src.width || h > 2 * src.height)
+    return false;
+
+  dst.width = w;
+  dst.height = h;
+  dst.red.resize(w * h);
+  dst.green.resize(w * h);
+  dst.blue.resize(w * h);
+  dst.intensity.resize(w * h);
+  dst.gray = src.gray;
+
+  expandPlane(&src.red[0], src.width, src.height, &dst.red[0], w, h);
+  expandPlane(&src.green[0], src.width, src.height, &dst.green[0], w, h);
+  expandPlane(&src.blue[0], src.width, src.height, &dst.blue[0], w, h);
+  expandPlane(&src.intensity[0], src.width, src.height, &dst.intensity[0], w, h);
+
+  return true;
+}
+
+/***************************************************************************//**
+ * expandToSize
+ * Author - Dan Andrus
+ *
+ * Expands a coarse level back up to a finer size, one octave at a time. The
+ * size of every intermediate step is derived from the target, so the result
+ * lines up with the image the level was reduced from.
+ *
+ * Parameters -
+ *          src - the level to expand
+ *          w - columns wanted
+ *          h - rows wanted
+ *          dst - receives the expanded level
+ *
+ * Returns
+ *          True if the operation was successful, false if not
+ ******************************************************************************/
+bool expandToSize(const ImagePlanes& src, int w, int h, ImagePlanes& dst)
+{
+  vector<int> widths(1, w);             // Size of each octave, finest first
+  vector<int> heights(1, h);
+  ImagePlanes tmp;                      // Current intermediate level
+
+  // Reproduce the chain of sizes reduce() produced on the way down
+  while (widths.back() > src.width || heights.back() > src.height)
+  {
+    widths.push_back((widths.back() + 1) / 2);
+    heights.push_back((heights.back() + 1) / 2);
+  }
+  if (widths.back() != src.width || heights.back() != src.height)
+    return false;
+
+  dst = src;
+  for (int k = (int) widths.size() - 2; k >= 0; k--)
+  {
+    if (!pyramidExpand(dst, widths[k], heights[k], tmp))
+      return false;
+    dst.width = tmp.width;
+    dst.height = tmp.height;
+    dst.red.swap(tmp.red);
+    dst.green.swap(tmp.green);
+    dst.blue.swap(tmp.blue);
+    dst.intensity.swap(tmp.intensity);
+  }
+
+  return true;
+}
+
+/***************************************************************************//**
+ * imageFromPlanes
+ * Author - Dan Andrus
+ *
+ * Creates an image the size of a set of planes and fills it with them. Used
+ * to hand a pyramid level to the filters that work on whole images.
+ *
+ * Parameters -
+ *          planes - the planes to copy
+ *          image - receives the new image
+ *
+ * Returns
+ *          True if the operation was successful, false if the planes are empty
+ ******************************************************************************/
+bool imageFromPlanes(const ImagePlanes& planes, Image& image)
+{
+  if (planes.width < 1 || planes.height < 1) return false;
+
+  image = Image(planes.height, planes.width);
+  packImage(planes, image);
+
+  return true;
+}
+
+/***************************************************************************//**
+ * ImagePyramid::update
+ * Author - Dan Andrus
+ *
+ * Makes the pyramid describe the given image with at least the requested
+ * number of levels above the base. If the image has the same pixels as the
+ * current base, the levels already built are kept and only missing ones are
+ * added.
+ *
+ * Parameters -
+ *          image - the image to build the pyramid of
+ *          levels - how many coarser levels are needed
+ *
+ * Returns
+ *          True if the operation was successful, false if not
+ ******************************************************************************/
+bool ImagePyramid::update(Image& image, int levels)
+{
+  ImagePlanes base;                     // The image as it is now
+  bool same;                            // Whether the cached base matches
+
+  if (!unpackImage(image, base)) return false;
+
+  same = !gaussian.empty() &&
+         gaussian[0].width == base.width &&
+         gaussian[0].height == base.height &&
+         memcmp(&gaussian[0].red[0], &base.red[0], base.red.size()) == 0 &&
+         memcmp(&gaussian[0].green[0], &base.green[0], base.green.size()) == 0 &&
+         memcmp(&gaussian[0].blue[0], &base.blue[0], base.blue.size()) == 0;
+
+  if (!same)
+  {
+    gaussian.assign(1, base);
+    laplacian.clear();
+    laplacian_built.clear();
+  }
+
+  // Add any levels that are missing, stopping once a level is a single pixel
+  while ((int) gaussian.size() <= levels)
+  {
+    ImagePlanes next;
+    if (!pyramidReduce(gaussian.back(), next)) break;
+    gaussian.push_back(next);
+  }
+
+  laplacian.resize(gaussian.size());
+  laplacian_built.resize(gaussian.size(), false);
+
+  return true;
+}
+
+/***************************************************************************//**
+ * ImagePyramid::levels
+ * Author - Dan Andrus
+ *
+ * Returns
+ *          The number of levels, including the full-size base
+ ******************************************************************************/
+int ImagePyramid::levels() const
+{
+  return (int) gaussian.size();
+}
+
+/***************************************************************************//**
+ * ImagePyramid::gaussianLevel
+ * Author - Dan Andrus
+ *
+ * Parameters -
+ *          level - the level wanted, 0 being full size
+ *
+ * Returns
+ *          The Gaussian level; the coarsest one if level is out of range
+ ******************************************************************************/
+const ImagePlanes& ImagePyramid::gaussianLevel(int level) const
+{
+  level = std::max(0, std::min(levels() - 1, level));
+  return gaussian[level];
+}
+
+/***************************************************************************//**
+ * ImagePyramid::laplacianLevel
+ * Author - Dan Andrus
+ *
+ * Returns a Laplacian level: the Gaussian level minus the expanded level
+ * above it, plus 128. The coarsest level is the Gaussian level itself. Levels
+ * are only built the first time they are asked for.
+ *
+ * Parameters -
+ *          level - the level wanted, 0 being full size
+ *
+ * Returns
+ *          The Laplacian level; the coarsest one if level is out of range
+ ******************************************************************************/
+const ImagePlanes& ImagePyramid::laplacianLevel(int level)
+{
+  level = std::max(0, std::min(levels() - 1, level));
+
+  if (!laplacian_built[level])
+  {
+    const ImagePlanes& fine = gaussian[level];
+    ImagePlanes& result = laplacian[level];
+
+    if (level == levels() - 1)
+      result = fine;
+    else
+    {
+      pyramidExpand(gaussian[level + 1], fine.width, fine.height, result);
+      int n = fine.width * fine.height;
+
+      #pragma omp parallel for
+      for (int k = 0; k < n; k++)
+      {
+        result.red[k] = (uchar) std::max(0, std::min(255, fine.red[k] - result.red[k] + 128));
+        result.green[k] = (uchar) std::max(0, std::min(255, fine.green[k] - result.green[k] + 128));
+        result.blue[k] = (uchar) std::max(0, std::min(255, fine.blue[k] - result.blue[k] + 128));
+        result.intensity[k] = (uchar) std::max(0, std::min(255, fine.intensity[k] - result.intensity[k] + 128));
+      }
+    }
+
+    laplacian_built[level] = true;
+  }
+
+  return laplacian[level];
+}
@@ -0,0 +1,44 @@
+/***************************************************************************//**
+ * pyramid.h
+ *
+ * Author - Dan Andrus
+ *
+ * Date - October 18, 2026
+ *
+ * Details - Contains the declaration for the ImagePyramid class and the
+ * reduce/expand steps it is built from.
+ *
+ ******************************************************************************/
+
+#pragma once
+#include "planes.h"
+
+/***************************************************************************//**
+ * ImagePyramid
+ *
+ * Author - Dan Andrus
+ *
+ * Gaussian and Laplacian pyramids of an image. Level 0 is the image itself
+ * and each level above it is half the width and height of the one below.
+ * update() keeps the levels already built as long as it is handed the same
+ * pixels again, so repeated queries on one image only build the pyramid once.
+ * Laplacian levels are stored offset by 128 so they fit in 8 bits.
+ ******************************************************************************/
+class ImagePyramid
+{
+  public:
+    bool update(Image& image, int levels);
+    int levels() const;
+    const ImagePlanes& gaussianLevel(int level) const;
+    const ImagePlanes& laplacianLevel(int level);
+
+  private:
+    vector<ImagePlanes> gaussian;       // Gaussian levels, finest first
+    vector<ImagePlanes> laplacian;      // Laplacian levels built so far
+    vector<bool> laplacian_built;       // Which Laplacian levels are current
+};
+
+bool pyramidReduce(const ImagePlanes& src, ImagePlanes& dst);
+bool pyramidExpand(const ImagePlanes& src, int w, int h, ImagePlanes& dst);
+bool expandToSize(const ImagePlanes& src, int w, int h, ImagePlanes& dst);
+bool imageFromPlanes(const ImagePlanes& planes, Image& image);
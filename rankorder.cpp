@@ -0,0 +1,247 @@
+/***************************************************************************//**
+ * rankorder.cpp
+ *
+ * Author - Derek Stotz
+ *
+ * Date - October 18, 2026
+ *
+ * Details - Rank order filters that keep a running histogram of the window
+ * instead of sorting it for every pixel (Huang's algorithm). Moving the window
+ * one pixel along a row removes one column and adds another, so the work per
+ * pixel grows with the filter width rather than its area. The histogram is
+ * kept at two levels, 16 coarse bins over 256 fine ones, so finding the
+ * median takes at most 32 steps. 16-bit planes use 256 coarse bins over
+ * 65536 fine ones, so the median takes at most 512.
+ *
+ ******************************************************************************/
+
+#include "rankorder.h"
+
+/***************************************************************************//**
+ * WindowHistogram
+ *
+ * Author - Derek Stotz
+ *
+ * Two-level histogram of the values under the filter window.
+ ******************************************************************************/
+template <class T>
+struct WindowHistogram
+{
+  // Each coarse bin covers 1 << shift values
+  static const int shift = PixelTraits<T>::levels > 256 ? 8 : 4;
+
+  vector<int> coarse;                   // Counts of values >> shift
+  vector<int> fine;                     // Counts of each value
+
+  WindowHistogram()
+    : coarse(PixelTraits<T>::levels >> shift), fine(PixelTraits<T>::levels) {}
+
+  void clear()
+  {
+    std::fill(coarse.begin(), coarse.end(), 0);
+    std::fill(fine.begin(), fine.end(), 0);
+  }
+
+  void add(T v, int n)
+  {
+    coarse[v >> shift] += n;
+    fine[v] += n;
+  }
+
+  // Returns the value of rank k (0 being the smallest)
+  int rank(int k) const
+  {
+    int c = 0, v;
+    while (k >= coarse[c])
+      k -= coarse[c++];
+    for (v = c << shift; k >= fine[v]; v++)
+      k -= fine[v];
+    return v;
+  }
+};
+/***************************************************************************//**
+ * medianArea
+ * Author - Derek Stotz
+ *
+ * Median filters one rectangle of one plane with a square window. Matches
+ * filterStatistic: pixels outside the image repeat the nearest valid pixel,
+ * an even-sized window is centred top-left of middle, and an even count
+ * averages the two middle values.
+ *
+ * Parameters -
+ *          src - the plane to filter
+ *          dst - receives the filtered rectangle
+ *          w - columns in the plane
+ *          h - rows in the plane
+ *          mask_w - the width (and height) of the window
+ *          area - the rectangle to filter
+ ******************************************************************************/
+template <class T>
+static void medianArea(const T* src, T* dst, int w, int h, int mask_w, const Rect& area)
+{
+  int center = mask_w / 2 - (1 - mask_w % 2);
+  int count = mask_w * mask_w;          // Values in every window
+  WindowHistogram<T> hist;
+  vector<const T*> rows(mask_w);        // Clamped rows under the window
+  int i, j, k, x;
+
+  for (i = area.y; i < area.y + area.h; i++)
+  {
+    for (k = 0; k < mask_w; k++)
+      rows[k] = src + std::max(0, std::min(h - 1, i + k - center)) * w;
+
+    // Fill the histogram for the first window in the row
+    hist.clear();
+    for (k = 0; k < mask_w; k++)
+    {
+      x = std::max(0, std::min(w - 1, area.x + k - center));
+      for (int r = 0; r < mask_w; r++)
+        hist.add(rows[r][x], 1);
+    }
+
+    for (j = area.x; j < area.x + area.w; j++)
+    {
+      if (count % 2)
+        dst[i * w + j] = (T) hist.rank(count / 2);
+      else
+        dst[i * w + j] = (T) ((hist.rank(count / 2) + hist.rank(count / 2 - 1)) / 2);
+
+      if (j + 1 == area.x + area.w) break;
+
+      // Slide right: drop the leftmost column, take in the next one
+      int out = std::max(0, std::min(w - 1, j - center));
+      int in = std::max(0, std::min(w - 1, j + 1 + mask_w - 1 - center));
+      if (out == in) continue;
+      for (int r = 0; r < mask_w; r++)
+      {
+        hist.add(rows[r][out], -1);
+        hist.add(rows[r][in], 1);
+      }
+    }
+  }
+}
+
+/***************************************************************************//**
+ * medianRows
+ * Author - Derek Stotz
+ *
+ * Median filters a whole plane of any pixel type. Rows are independent, so
+ * bands of them are split across threads, and the histogram of each band is
+ * only set up once.
+ *
+ * Parameters -
+ *          src - the plane to filter
+ *          dst - receives the filtered plane
+ *          w - columns in the plane
+ *          h - rows in the plane
+ *          mask_w - the width (and height) of the window
+ ******************************************************************************/
+template <class T>
+static void medianRows(const T* src, T* dst, int w, int h, int mask_w)
+{
+  #pragma omp parallel for schedule(dynamic)
+  for (int i = 0; i < h; i += NEIGHBORHOOD_BAND)
+    medianArea(src, dst, w, h, mask_w, makeRect(0, i, w, min(NEIGHBORHOOD_BAND, h - i)));
+}
+
+/***************************************************************************//**
+ * medianPlane
+ * Author - Derek Stotz
+ *
+ * Median filters a whole 8-bit or 16-bit plane; see medianRows.
+ *
+ * Parameters -
+ *          src - the plane to filter
+ *          dst - receives the filtered plane
+ *          w - columns in the plane
+ *          h - rows in the plane
+ *          mask_w - the width (and height) of the window
+ ******************************************************************************/
+void medianPlane(const uchar* src, uchar* dst, int w, int h, int mask_w)
+{
+  medianRows(src, dst, w, h, mask_w);
+}
+
+void medianPlane(const unsigned short* src, unsigned short* dst, int w, int h, int mask_w)
+{
+  medianRows(src, dst, w, h, mask_w);
+}
+
+/***************************************************************************//**
+ * medianPlanes
+ * Author - Derek Stotz
+ *
+ * Median filters the red, green and blue planes of an unpacked image, or just
+ * one of them for a grey image. Safe to call from any thread, since it never
+ * touches a QtImageLib image.
+ *
+ * Parameters -
+ *          src - the unpacked image to filter
+ *          dst - receives the filtered image
+ *          mask_w - the width (and height) of the window
+ *
+ * Returns
+ *          True if the operation was successful, false if not
+ ******************************************************************************/
+bool medianPlanes(const ImagePlanes& src, ImagePlanes& dst, int mask_w)
+{
+  int n = src.width * src.height;       // Values per plane
+
+  if (n == 0 || mask_w < 1) return false;
+
+  dst.width = src.width;
+  dst.height = src.height;
+  dst.red.resize(n);
+  dst.green.resize(n);
+  dst.blue.resize(n);
+  dst.intensity = src.intensity;
+  dst.gray = src.gray;
+
+  medianPlane(&src.red[0], &dst.red[0], src.width, src.height, mask_w);
+
+  // A grey image has the same median in every channel
+  if (src.gray)
+  {
+    dst.green = dst.red;
+    dst.blue = dst.red;
+    return true;
+  }
+
+  medianPlane(&src.green[0], &dst.green[0], src.width, src.height, mask_w);
+  medianPlane(&src.blue[0], &dst.blue[0], src.width, src.height, mask_w);
+
+  return true;
+}
+
+/***************************************************************************//**
+ * medianBand
+ * Author - Derek Stotz
+ *
+ * The histogram median of one rectangle of an unpacked image, for the band
+ * filters; gives the same result as statisticBand with Median.
+ *
+ * Parameters -
+ *          src - the unpacked image to filter
+ *          dst - receives the filtered rectangle; same size as src
+ *          area - the rectangle of src to filter
+ *          mask_w - the width (and height) of the window
+ ******************************************************************************/
+void medianBand(const ImagePlanes& src, ImagePlanes& dst, const Rect& area, int mask_w)
+{
+  medianArea(&src.red[0], &dst.red[0], src.width, src.height, mask_w, area);
+
+  // A grey image has the same median in every channel
+  if (src.gray)
+  {
+    for (int i = area.y; i < area.y + area.h; i++)
+    {
+      int k = i * src.width + area.x;
+      std::copy(dst.red.begin() + k, dst.red.begin() + k + area.w, dst.green.begin() + k);
+      std::copy(dst.red.begin() + k, dst.red.begin() + k + area.w, dst.blue.begin() + k);
+    }
+    return;
+  }
+
+  medianArea(&src.green[0], &dst.green[0], src.width, src.height, mask_w, area);
+  medianArea(&src.blue[0], &dst.blue[0], src.width, src.height, mask_w, area);
+}
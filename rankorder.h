@@ -0,0 +1,19 @@
+/***************************************************************************//**
+ * rankorder.h
+ *
+ * Author - Derek Stotz
+ *
+ * Date - October 18, 2026
+ *
+ * Details - Contains the declarations for the histogram-based rank order
+ * filters that work on unpacked images and on single 8 or 16-bit planes.
+ *
+ ******************************************************************************/
+
+#pragma once
+#include "neighborhood.h"
+
+void medianPlane(const uchar* src, uchar* dst, int w, int h, int mask_w);
+void medianPlane(const unsigned short* src, unsigned short* dst, int w, int h, int mask_w);
+bool medianPlanes(const ImagePlanes& src, ImagePlanes& dst, int mask_w);
+void medianBand(const ImagePlanes& src, ImagePlanes& dst, const Rect& area, int mask_w);
@@ -0,0 +1,271 @@
+/***************************************************************************//**
+ * region.cpp
+ *
+ * Author - Dan Andrus
+ *
+ * Date - October 18, 2026
+ *
+ * Details - Rectangle helpers and the list of active regions. While any
+ * regions are active, the filters only compute pixels inside them (reading
+ * whatever halo their mask needs around them) and leave the rest of the image
+ * untouched.
+ *
+ ******************************************************************************/
+
+#include "region.h"
+
+// Regions set from the Region menu; empty means the whole image
+static vector<Rect> active_regions;
+
+/***************************************************************************//**
+ * makeRect
+ * Author - Dan Andrus
+ *
+ * Parameters -
+ *          x, y - top-left corner
+ *          w, h - width and height
+ *
+ * Returns
+ *          The rectangle
+ ******************************************************************************/
+Rect makeRect(int x, int y, int w, int h)
+{
+  Rect r;
+  r.x = x;
+  r.y = y;
+  r.w = w;
+  r.h = h;
+  return r;
+}
+
+/***************************************************************************//**
+ * clipRect
+ * Author - Dan Andrus
+ *
+ * Parameters -
+ *          r - the rectangle to clip
+ *          img_w, img_h - size of the image to clip it to
+ *
+ * Returns
+ *          The part of the rectangle inside the image, possibly empty
+ ******************************************************************************/
+Rect clipRect(const Rect& r, int img_w, int img_h)
+{
+  int x0 = std::max(0, r.x);
+  int y0 = std::max(0, r.y);
+  int x1 = std::min(img_w, r.x + r.w);
+  int y1 = std::min(img_h, r.y + r.h);
+
+  return makeRect(x0, y0, std::max(0, x1 - x0), std::max(0, y1 - y0));
+}
+
+/***************************************************************************//**
+ * padRect
+ * Author - Dan Andrus
+ *
+ * Grows a rectangle by a halo on every side, staying inside the image. This
+ * is the area a mask filter has to read to compute the rectangle.
+ *
+ * Parameters -
+ *          r - the rectangle to grow
+ *          halo - pixels to add on each side
+ *          img_w, img_h - size of the image
+ *
+ * Returns
+ *          The grown rectangle
+ ******************************************************************************/
+Rect padRect(const Rect& r, int halo, int img_w, int img_h)
+{
+  return clipRect(makeRect(r.x - halo, r.y - halo, r.w + 2 * halo, r.h + 2 * halo),
+                  img_w, img_h);
+}
+
+/***************************************************************************//**
+ * boundingRect
+ * Author - Dan Andrus
+ *
+ * Parameters -
+ *          rects - the rectangles to cover
+ *
+ * Returns
+ *          The smallest rectangle containing all of them
+ ******************************************************************************/
+Rect boundingRect(const vector<Rect>& rects)
+{
+  int x0 = 0, y0 = 0, x1 = 0, y1 = 0;
+  bool first = true;
+
+  for (size_t k = 0; k < rects.size(); k++)
+  {
+    if (emptyRect(rects[k])) continue;
+
+    if (first)
+    {
+      x0 = rects[k].x;
+      y0 = rects[k].y;
+      x1 = rects[k].x + rects[k].w;
+      y1 = rects[k].y + rects[k].h;
+      first = false;
+      continue;
+    }
+
+    x0 = std::min(x0, rects[k].x);
+    y0 = std::min(y0, rects[k].y);
+    x1 = std::max(x1, rects[k].x + rects[k].w);
+    y1 = std::max(y1, rects[k].y + rects[k].h);
+  }
+
+  return makeRect(x0, y0, x1 - x0, y1 - y0);
+}
+
+/***************************************************************************//**
+ * emptyRect
+ * Author - Dan Andrus
+ *
+ * Returns
+ *          True if the rectangle holds no pixels
+ ******************************************************************************/
+bool emptyRect(const Rect& r)
+{
+  return r.w <= 0 || r.h <= 0;
+}
+
+/***************************************************************************//**
+ * setActiveRegions
+ * Author - Dan Andrus
+ *
+ * Restricts the filters to a list of rectangles, such as an inspection window
+ * or the dirty rectangles of a partial update.
+ *
+ * Parameters -
+ *          rects - the regions to process
+ ******************************************************************************/
+void setActiveRegions(const vector<Rect>& rects)
+{
+  active_regions = rects;
+}
+
+/***************************************************************************//**
+ * addActiveRegion
+ * Author - Dan Andrus
+ *
+ * Adds one more rectangle to the regions the filters process.
+ *
+ * Parameters -
+ *          r - the region to add
+ ******************************************************************************/
+void addActiveRegion(const Rect& r)
+{
+  active_regions.push_back(r);
+}
+
+/***************************************************************************//**
+ * activeRegions
+ * Author - Dan Andrus
+ *
+ * Returns
+ *          The regions the filters currently process; empty for whole images
+ ******************************************************************************/
+vector<Rect> activeRegions()
+{
+  return active_regions;
+}
+
+/***************************************************************************//**
+ * clearActiveRegions
+ * Author - Dan Andrus
+ *
+ * Lets the filters process whole images again.
+ ******************************************************************************/
+void clearActiveRegions()
+{
+  active_regions.clear();
+}
+
+/***************************************************************************//**
+ * cutRect
+ * Author - Dan Andrus
+ *
+ * Removes one rectangle from another. What is left is returned as up to four
+ * rectangles: the full-width bands above and below the cut, and the parts to
+ * its left and right between them.
+ *
+ * Parameters -
+ *          r - the rectangle to cut
+ *          cut - the rectangle to remove from it
+ *          pieces - receives the parts of r outside cut
+ ******************************************************************************/
+static void cutRect(const Rect& r, const Rect& cut, vector<Rect>& pieces)
+{
+  int x0 = std::max(r.x, cut.x);        // Overlap of the two rectangles
+  int y0 = std::max(r.y, cut.y);
+  int x1 = std::min(r.x + r.w, cut.x + cut.w);
+  int y1 = std::min(r.y + r.h, cut.y + cut.h);
+
+  // Nothing to remove
+  if (x0 >= x1 || y0 >= y1)
+  {
+    pieces.push_back(r);
+    return;
+  }
+
+  if (y0 > r.y)
+    pieces.push_back(makeRect(r.x, r.y, r.w, y0 - r.y));
+  if (y1 < r.y + r.h)
+    pieces.push_back(makeRect(r.x, y1, r.w, r.y + r.h - y1));
+  if (x0 > r.x)
+    pieces.push_back(makeRect(r.x, y0, x0 - r.x, y1 - y0));
+  if (x1 < r.x + r.w)
+    pieces.push_back(makeRect(x1, y0, r.x + r.w - x1, y1 - y0));
+}
+
+/***************************************************************************//**
+ * imageRegions
+ * Author - Dan Andrus
+ *
+ * Works out which rectangles of an image a filter should compute: the given
+ * list if there is one, otherwise the active regions, otherwise the whole
+ * image. Rectangles are clipped to the image and empty ones dropped, and
+ * overlaps are cut away so that every pixel lies in exactly one of them; a
+ * filter that works in place, such as a lookup table, then changes each
+ * pixel once.
+ *
+ * Parameters -
+ *          img_w, img_h - size of the image
+ *          regions - rectangles asked for by the caller, or null
+ *
+ * Returns
+ *          Disjoint rectangles to compute; empty if none fall inside the image
+ ******************************************************************************/
+vector<Rect> imageRegions(int img_w, int img_h, const vector<Rect>* regions)
+{
+  const vector<Rect>& wanted = regions ? *regions : active_regions;
+  vector<Rect> result;
+
+  if (wanted.empty())
+  {
+    result.push_back(makeRect(0, 0, img_w, img_h));
+    return result;
+  }
+
+  for (size_t k = 0; k < wanted.size(); k++)
+  {
+    vector<Rect> pieces(1, clipRect(wanted[k], img_w, img_h));
+    vector<Rect> left;                  // Pieces not yet covered
+
+    // Keep only the parts no earlier rectangle covers
+    for (size_t e = 0; e < result.size() && !pieces.empty(); e++)
+    {
+      left.clear();
+      for (size_t p = 0; p < pieces.size(); p++)
+        cutRect(pieces[p], result[e], left);
+      pieces.swap(left);
+    }
+
+    for (size_t p = 0; p < pieces.size(); p++)
+      if (!emptyRect(pieces[p]))
+        result.push_back(pieces[p]);
+  }
+
+  return result;
+}
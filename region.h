@@ -0,0 +1,41 @@
+/***************************************************************************//**
+ * region.h
+ *
+ * Author - Dan Andrus
+ *
+ * Date - October 18, 2026
+ *
+ * Details - Contains the declarations for restricting filters to rectangular
+ * regions of an image.
+ *
+ ******************************************************************************/
+
+#pragma once
+#include "toolbox.h"
+
+/***************************************************************************//**
+ * Rect
+ *
+ * Author - Dan Andrus
+ *
+ * A rectangle of pixels: columns x to x + w - 1 of rows y to y + h - 1.
+ ******************************************************************************/
+struct Rect
+{
+  int x;                                // First column
+  int y;                                // First row
+  int w;                                // Number of columns
+  int h;                                // Number of rows
+};
+
+Rect makeRect(int x, int y, int w, int h);
+Rect clipRect(const Rect& r, int img_w, int img_h);
+Rect padRect(const Rect& r, int halo, int img_w, int img_h);
+Rect boundingRect(const vector<Rect>& rects);
+bool emptyRect(const Rect& r);
+
+void setActiveRegions(const vector<Rect>& rects);
+void addActiveRegion(const Rect& r);
+void clearActiveRegions();
+vector<Rect> activeRegions();
+vector<Rect> imageRegions(int img_w, int img_h, const vector<Rect>* regions = 0);
@@ -0,0 +1,425 @@
+/***************************************************************************//**
+ * resultcache.cpp
+ *
+ * Author - Dan Andrus
+ *
+ * Date - October 18, 2026
+ *
+ * Details - A bounded least-recently-used cache of filter outputs, keyed by a
+ * 64-bit hash of the input pixels. The hash is xxHash64, taken over fixed
+ * 64 KiB chunks of each plane in parallel and then over the chunk hashes, so
+ * it does not depend on the number of threads. Hashing a plane costs a small
+ * fraction of even a 3x3 mask.
+ *
+ ******************************************************************************/
+
+#include "resultcache.h"
+#include <cstdio>
+#include <cstring>
+
+// xxHash64 primes
+static const unsigned long long PRIME1 = 11400714785074694791ULL;
+static const unsigned long long PRIME2 = 14029467366897019727ULL;
+static const unsigned long long PRIME3 = 1609587929392839161ULL;
+static const unsigned long long PRIME4 = 9650029242287828579ULL;
+static const unsigned long long PRIME5 = 2870177450012600261ULL;
+
+// Bytes of a plane hashed as one piece
+static const size_t HASH_CHUNK = 65536;
+
+// Budget for a new cache
+static const size_t DEFAULT_BUDGET = 64 << 20;
+
+/***************************************************************************//**
+ * rotl64
+ * Author - Dan Andrus
+ *
+ * Rotates a 64-bit word left.
+ ******************************************************************************/
+static inline unsigned long long rotl64(unsigned long long x, int r)
+{
+  return (x << r) | (x >> (64 - r));
+}
+
+/***************************************************************************//**
+ * read64
+ * Author - Dan Andrus
+ *
+ * Reads eight possibly unaligned bytes as a word.
+ ******************************************************************************/
+static inline unsigned long long read64(const uchar* p)
+{
+  unsigned long long v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+/***************************************************************************//**
+ * read32
+ * Author - Dan Andrus
+ *
+ * Reads four possibly unaligned bytes as a word.
+ ******************************************************************************/
+static inline unsigned long long read32(const uchar* p)
+{
+  uint v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+/***************************************************************************//**
+ * hashRound
+ * Author - Dan Andrus
+ *
+ * Mixes one input word into an xxHash64 accumulator.
+ ******************************************************************************/
+static inline unsigned long long hashRound(unsigned long long acc, unsigned long long input)
+{
+  acc += input * PRIME2;
+  acc = rotl64(acc, 31);
+  return acc * PRIME1;
+}
+
+/***************************************************************************//**
+ * mergeRound
+ * Author - Dan Andrus
+ *
+ * Folds one of the four lane accumulators into the hash.
+ ******************************************************************************/
+static inline unsigned long long mergeRound(unsigned long long acc, unsigned long long val)
+{
+  acc ^= hashRound(0, val);
+  return acc * PRIME1 + PRIME4;
+}
+
+/***************************************************************************//**
+ * hashBytes
+ * Author - Dan Andrus
+ *
+ * The xxHash64 hash of a block of bytes. Four independent lanes of 8 bytes
+ * each are run side by side, which keeps the multiplier busy.
+ *
+ * Parameters -
+ *          data - the bytes to hash
+ *          len - number of bytes
+ *          seed - starting value; different seeds give unrelated hashes
+ *
+ * Returns
+ *          The 64-bit hash
+ ******************************************************************************/
+unsigned long long hashBytes(const uchar* data, size_t len, unsigned long long seed)
+{
+  const uchar* p = data;
+  const uchar* end = data + len;
+  unsigned long long h;
+
+  if (len >= 32)
+  {
+    unsigned long long v1 = seed + PRIME1 + PRIME2;
+    unsigned long long v2 = seed + PRIME2;
+    unsigned long long v3 = seed;
+    unsigned long long v4 = seed - PRIME1;
+
+    for (; p + 32 <= end; p += 32)
+    {
+      v1 = hashRound(v1, read64(p));
+      v2 = hashRound(v2, read64(p + 8));
+      v3 = hashRound(v3, read64(p + 16));
+      v4 = hashRound(v4, read64(p + 24));
+    }
+
+    h = rotl64(v1, 1) + rotl64(v2, 7) + rotl64(v3, 12) + rotl64(v4, 18);
+    h = mergeRound(h, v1);
+    h = mergeRound(h, v2);
+    h = mergeRound(h, v3);
+    h = mergeRound(h, v4);
+  }
+  else
+    h = seed + PRIME5;
+
+  h += len;
+
+  // The tail that does not fill a whole stripe
+  for (; p + 8 <= end; p += 8)
+    h = rotl64(h ^ hashRound(0, read64(p)), 27) * PRIME1 + PRIME4;
+  if (p + 4 <= end)
+  {
+    h = rotl64(h ^ (read32(p) * PRIME1), 23) * PRIME2 + PRIME3;
+    p += 4;
+  }
+  for (; p < end; p++)
+    h = rotl64(h ^ (*p * PRIME5), 11) * PRIME1;
+
+  // Final avalanche
+  h ^= h >> 33;
+  h *= PRIME2;
+  h ^= h >> 29;
+  h *= PRIME3;
+  h ^= h >> 32;
+  return h;
+}
+
+/***************************************************************************//**
+ * hashPlanes
+ * Author - Dan Andrus
+ *
+ * Hashes the red, green and blue planes and the size of an unpacked image.
+ * The intensity plane follows from the others and is skipped.
+ *
+ * Parameters -
+ *          planes - the unpacked image
+ *
+ * Returns
+ *          The 64-bit hash
+ ******************************************************************************/
+unsigned long long hashPlanes(const ImagePlanes& planes)
+{
+  const uchar* data[3];                 // Start of each plane
+  size_t n = (size_t)planes.width * planes.height;
+  int per_plane = (int)((n + HASH_CHUNK - 1) / HASH_CHUNK);
+  int chunks = 3 * per_plane;
+  vector<unsigned long long> sums(chunks + 1);
+
+  if (n == 0) return 0;
+
+  data[0] = &planes.red[0];
+  data[1] = &planes.green[0];
+  data[2] = &planes.blue[0];
+
+  #pragma omp parallel for
+  for (int c = 0; c < chunks; c++)
+  {
+    size_t begin = (size_t)(c % per_plane) * HASH_CHUNK;
+    size_t len = std::min(HASH_CHUNK, n - begin);
+
+    sums[c] = hashBytes(data[c / per_plane] + begin, len, c);
+  }
+
+  sums[chunks] = ((unsigned long long)planes.width << 32) | (uint)planes.height;
+  return hashBytes((const uchar*)&sums[0], sums.size() * sizeof(sums[0]), 0);
+}
+
+/***************************************************************************//**
+ * ResultCache::ResultCache
+ * Author - Dan Andrus
+ *
+ * Creates an empty cache with the default budget.
+ ******************************************************************************/
+ResultCache::ResultCache()
+  : limit(DEFAULT_BUDGET), used(0), hit_count(0), miss_count(0)
+{
+}
+
+/***************************************************************************//**
+ * ResultCache::lookup
+ * Author - Dan Andrus
+ *
+ * Looks for the output of a filter on an image, marking it most recently used
+ * if found.
+ *
+ * Parameters -
+ *          filter - names the filter and its parameters
+ *          hash - hash of the filter's input
+ *          result - receives a copy of the output if found
+ *
+ * Returns
+ *          True if the output was in the cache, false if not
+ ******************************************************************************/
+bool ResultCache::lookup(const string& filter, unsigned long long hash, ImagePlanes& result)
+{
+  char text[32];
+  sprintf(text, " #%016llx", hash);
+
+  std::map<string, std::list<Entry>::iterator>::iterator found = index.find(filter + text);
+  if (found == index.end())
+  {
+    miss_count++;
+    return false;
+  }
+
+  order.splice(order.begin(), order, found->second);
+  result = found->second->result;
+  hit_count++;
+  return true;
+}
+
+/***************************************************************************//**
+ * ResultCache::store
+ * Author - Dan Andrus
+ *
+ * Keeps the output of a filter, dropping the least recently used entries if
+ * the budget is exceeded. An output bigger than the whole budget is not kept.
+ *
+ * Parameters -
+ *          filter - names the filter and its parameters
+ *          hash - hash of the filter's input
+ *          result - the filter's output
+ ******************************************************************************/
+void ResultCache::store(const string& filter, unsigned long long hash, const ImagePlanes& result)
+{
+  char text[32];
+  sprintf(text, " #%016llx", hash);
+
+  string key = filter + text;
+  size_t bytes = 3 * result.red.size() + key.size();
+
+  if (bytes > limit || index.count(key)) return;
+
+  order.push_front(Entry());
+  order.front().key = key;
+  order.front().result.width = result.width;
+  order.front().result.height = result.height;
+  order.front().result.red = result.red;
+  order.front().result.green = result.green;
+  order.front().result.blue = result.blue;
+  order.front().bytes = bytes;
+  index[key] = order.begin();
+  used += bytes;
+
+  trim();
+}
+
+/***************************************************************************//**
+ * ResultCache::trim
+ * Author - Dan Andrus
+ *
+ * Drops least recently used entries until the cache fits its budget.
+ ******************************************************************************/
+void ResultCache::trim()
+{
+  while (used > limit && !order.empty())
+  {
+    used -= order.back().bytes;
+    index.erase(order.back().key);
+    order.pop_back();
+  }
+}
+
+/***************************************************************************//**
+ * ResultCache::setBudget
+ * Author - Dan Andrus
+ *
+ * Changes how many bytes of outputs may be kept.
+ *
+ * Parameters -
+ *          bytes - the new budget
+ ******************************************************************************/
+void ResultCache::setBudget(size_t bytes)
+{
+  limit = bytes;
+  trim();
+}
+
+/***************************************************************************//**
+ * ResultCache::budget
+ * Author - Dan Andrus
+ *
+ * Returns
+ *          How many bytes of outputs may be kept
+ ******************************************************************************/
+size_t ResultCache::budget() const
+{
+  return limit;
+}
+
+/***************************************************************************//**
+ * ResultCache::bytesUsed
+ * Author - Dan Andrus
+ *
+ * Returns
+ *          How many bytes the kept outputs take
+ ******************************************************************************/
+size_t ResultCache::bytesUsed() const
+{
+  return used;
+}
+
+/***************************************************************************//**
+ * ResultCache::entries
+ * Author - Dan Andrus
+ *
+ * Returns
+ *          The number of outputs kept
+ ******************************************************************************/
+int ResultCache::entries() const
+{
+  return (int)order.size();
+}
+
+/***************************************************************************//**
+ * ResultCache::hits
+ * Author - Dan Andrus
+ *
+ * Returns
+ *          The number of lookups that found an output
+ ******************************************************************************/
+int ResultCache::hits() const
+{
+  return hit_count;
+}
+
+/***************************************************************************//**
+ * ResultCache::misses
+ * Author - Dan Andrus
+ *
+ * Returns
+ *          The number of lookups that did not find an output
+ ******************************************************************************/
+int ResultCache::misses() const
+{
+  return miss_count;
+}
+
+/***************************************************************************//**
+ * ResultCache::clear
+ * Author - Dan Andrus
+ *
+ * Drops every output and resets the statistics.
+ ******************************************************************************/
+void ResultCache::clear()
+{
+  order.clear();
+  index.clear();
+  used = 0;
+  hit_count = 0;
+  miss_count = 0;
+}
+
+/***************************************************************************//**
+ * resultCache
+ * Author - Dan Andrus
+ *
+ * Returns
+ *          The cache shared by all the menus
+ ******************************************************************************/
+ResultCache& resultCache()
+{
+  static ResultCache cache;
+  return cache;
+}
+
+/***************************************************************************//**
+ * regionKey
+ * Author - Dan Andrus
+ *
+ * Describes the rectangles a filter will compute, for use in a cache key.
+ *
+ * Parameters -
+ *          rects - the rectangles, relative to the pixels that are hashed
+ *
+ * Returns
+ *          The rectangles as text
+ ******************************************************************************/
+string regionKey(const vector<Rect>& rects)
+{
+  string key;
+  char text[64];
+
+  for (size_t r = 0; r < rects.size(); r++)
+  {
+    sprintf(text, " [%d,%d %dx%d]", rects[r].x, rects[r].y, rects[r].w, rects[r].h);
+    key += text;
+  }
+
+  return key;
+}
@@ -0,0 +1,65 @@
+/***************************************************************************//**
+ * resultcache.h
+ *
+ * Author - Dan Andrus
+ *
+ * Date - October 18, 2026
+ *
+ * Details - Contains the declarations for the content hash and the bounded
+ * cache of filter results.
+ *
+ ******************************************************************************/
+
+#pragma once
+#include "planes.h"
+#include <list>
+#include <map>
+#include <string>
+
+unsigned long long hashBytes(const uchar* data, size_t len, unsigned long long seed);
+unsigned long long hashPlanes(const ImagePlanes& planes);
+
+/***************************************************************************//**
+ * ResultCache
+ *
+ * Author - Dan Andrus
+ *
+ * Least-recently-used cache of filter outputs. Each entry is keyed by the
+ * filter, its parameters and a hash of the pixels it was given, so running the
+ * same filter on the same image again hands back the earlier output. Entries
+ * are dropped oldest first once their pixels exceed the byte budget.
+ ******************************************************************************/
+class ResultCache
+{
+  public:
+    ResultCache();
+    bool lookup(const string& filter, unsigned long long hash, ImagePlanes& result);
+    void store(const string& filter, unsigned long long hash, const ImagePlanes& result);
+    void setBudget(size_t bytes);
+    size_t budget() const;
+    size_t bytesUsed() const;
+    int entries() const;
+    int hits() const;
+    int misses() const;
+    void clear();
+
+  private:
+    struct Entry
+    {
+      string key;                       // Filter, parameters and hash
+      ImagePlanes result;               // Red, green and blue of the output
+      size_t bytes;                     // Memory held by the entry
+    };
+
+    void trim();
+
+    std::list<Entry> order;             // Most recently used first
+    std::map<string, std::list<Entry>::iterator> index; // Entries by key
+    size_t limit;                       // Byte budget
+    size_t used;                        // Bytes held by all entries
+    int hit_count;                      // Lookups that found an entry
+    int miss_count;                     // Lookups that did not
+};
+
+ResultCache& resultCache();
+string regionKey(const vector<Rect>& rects);
@@ -0,0 +1,75 @@
+/***************************************************************************//**
+ * sparsemask.cpp
+ *
+ * Author - Dan Andrus
+ *
+ * Date - October 18, 2026
+ *
+ * Details - Convolution with masks that are mostly zeros. The emboss mask has
+ * 2 non-zero taps out of 9 and a ring detector far fewer than its square, so
+ * the mask is compiled into a list of its non-zero taps and the cost of a
+ * pixel follows the number of those taps rather than the size of the mask.
+ *
+ ******************************************************************************/
+
+#include "sparsemask.h"
+
+/***************************************************************************//**
+ * compileMask
+ * Author - Dan Andrus
+ *
+ * Collects the non-zero taps of a mask, grouped by weight. The center is
+ * found as in the filters: for an even size, the top-left of the center 4.
+ *
+ * Parameters -
+ *          mask - the 2d integer mask
+ *          mask_w - columns in the mask
+ *          mask_h - rows in the mask
+ *
+ * Returns
+ *          The compiled mask
+ ******************************************************************************/
+SparseMask compileMask(int** mask, int mask_w, int mask_h)
+{
+  SparseMask sparse;                    // The mask being built
+  int center_x;                         // Center of mask
+  int center_y;                         // Center of mask
+  size_t g;                             // Group of the current weight
+  int i, j;                             // Temporary variables
+
+  center_x = mask_w / 2 - (1 - mask_w % 2);
+  center_y = mask_h / 2 - (1 - mask_h % 2);
+
+  sparse.taps = 0;
+  sparse.sum = 0;
+  sparse.left = sparse.right = sparse.top = sparse.bottom = 0;
+
+  for (i = 0; i < mask_h; ++i)
+  {
+    for (j = 0; j < mask_w; ++j)
+    {
+      sparse.sum += mask[i][j];
+      if (mask[i][j] == 0) continue;
+
+      for (g = 0; g < sparse.groups.size(); ++g)
+        if (sparse.groups[g].weight == mask[i][j]) break;
+
+      if (g == sparse.groups.size())
+      {
+        sparse.groups.push_back(TapGroup());
+        sparse.groups[g].weight = mask[i][j];
+      }
+
+      sparse.groups[g].dx.push_back(j - center_x);
+      sparse.groups[g].dy.push_back(i - center_y);
+      sparse.taps++;
+
+      sparse.left = max(sparse.left, center_x - j);
+      sparse.right = max(sparse.right, j - center_x);
+      sparse.top = max(sparse.top, center_y - i);
+      sparse.bottom = max(sparse.bottom, i - center_y);
+    }
+  }
+
+  return sparse;
+}
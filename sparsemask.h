@@ -0,0 +1,192 @@
+/***************************************************************************//**
+ * sparsemask.h
+ *
+ * Author - Dan Andrus
+ *
+ * Date - October 18, 2026
+ *
+ * Details - Contains the declarations for compiling an integer mask into a
+ * list of its non-zero taps, so a convolution only visits those taps.
+ *
+ ******************************************************************************/
+
+#pragma once
+#include "neighborhood.h"
+
+/***************************************************************************//**
+ * TapGroup
+ *
+ * Author - Dan Andrus
+ *
+ * The taps of a mask that share one weight. The pixels under them are summed
+ * first and multiplied by the weight once.
+ ******************************************************************************/
+struct TapGroup
+{
+  int weight;                           // Weight shared by every tap
+  vector<int> dx;                       // Column offsets from the center
+  vector<int> dy;                       // Row offsets from the center
+};
+
+/***************************************************************************//**
+ * SparseMask
+ *
+ * Author - Dan Andrus
+ *
+ * A mask reduced to its non-zero taps, grouped by weight. The reach is how far
+ * the taps extend from the center, which is all the border that has to be
+ * padded; taps of weight zero never count.
+ ******************************************************************************/
+struct SparseMask
+{
+  vector<TapGroup> groups;              // Non-zero taps, one group per weight
+  int taps;                             // Number of non-zero taps
+  int sum;                              // Sum of every weight in the mask
+  int left;                             // Columns reached left of center
+  int right;                            // Columns reached right of center
+  int top;                              // Rows reached above center
+  int bottom;                           // Rows reached below center
+};
+
+SparseMask compileMask(int** mask, int mask_w, int mask_h);
+
+/***************************************************************************//**
+ * sparseRow
+ * Author - Dan Andrus
+ *
+ * Takes the weighted sum of the non-zero taps of a mask at every pixel of a
+ * row. The pixels under the taps of a group are added up along the whole row
+ * before the group's weight is applied, so each tap is a plain run of adds
+ * and each weight costs one multiply per pixel. The adds are done in the
+ * narrow lanes of the pixel type, a chunk of taps at a time, and only the
+ * weighted totals are widened.
+ *
+ * Parameters -
+ *          mask - the compiled mask
+ *          rows - the padded rows under the mask, as given to a reducer
+ *          n - pixels in the row
+ *          acc - scratch space for the pixels under one chunk of a group
+ *          sums - receives the n weighted sums
+ ******************************************************************************/
+template <class T>
+void sparseRow(const SparseMask& mask, const T* const* rows, int n,
+               vector<typename PixelTraits<T>::lane>& acc,
+               vector<typename PixelTraits<T>::sum>& sums)
+{
+  typedef typename PixelTraits<T>::sum sum_t;
+  int taps;                             // Taps in the current group
+  int t0, t1, t;                        // Chunk of taps being added
+  int x;
+
+  acc.resize(n);
+  sums.assign(n, 0);
+
+  for (size_t g = 0; g < mask.groups.size(); ++g)
+  {
+    const TapGroup& group = mask.groups[g];
+    sum_t weight = group.weight;
+
+    taps = (int) group.dx.size();
+    for (t0 = 0; t0 < taps; t0 = t1)
+    {
+      t1 = taps - t0 > PixelTraits<T>::lane_taps ? t0 + PixelTraits<T>::lane_taps : taps;
+
+      const T* p = rows[group.dy[t0] + mask.top] + group.dx[t0] + mask.left;
+      for (x = 0; x < n; x++)
+        acc[x] = p[x];
+
+      for (t = t0 + 1; t < t1; ++t)
+      {
+        p = rows[group.dy[t] + mask.top] + group.dx[t] + mask.left;
+        for (x = 0; x < n; x++)
+          acc[x] += p[x];
+      }
+
+      if (group.weight == 1)
+        for (x = 0; x < n; x++)
+          sums[x] += acc[x];
+      else if (group.weight == -1)
+        for (x = 0; x < n; x++)
+          sums[x] -= acc[x];
+      else
+        for (x = 0; x < n; x++)
+          sums[x] += weight * acc[x];
+    }
+  }
+}
+
+/***************************************************************************//**
+ * MaskAverage
+ * Author - Dan Andrus
+ *
+ * Reducer for filterAverage: the weighted sum of the non-zero taps of a mask,
+ * divided by the sum of its weights and clipped to the pixel type.
+ ******************************************************************************/
+template <class T>
+struct MaskAverage
+{
+  static const planeInput input = ColourInput;
+
+  MaskShape shape;                      // Reach of the non-zero taps
+  SparseMask mask;                      // The compiled mask
+  typename PixelTraits<T>::sum divisor; // Sum of the weights, at least 1
+  vector<typename PixelTraits<T>::lane> acc;  // Scratch space for sparseRow
+  vector<typename PixelTraits<T>::sum> sums;  // Weighted sums of a row
+
+  MaskAverage(const SparseMask& m)
+    : shape(m.left, m.right, m.top, m.bottom), mask(m), divisor(max(m.sum, 1)) {}
+
+  void reduceRow(const T* const* rows, int n, T* out)
+  {
+    // Average out the sum, truncating decimals for integer pixels, and clip
+    sparseRow(mask, rows, n, acc, sums);
+    for (int x = 0; x < n; x++)
+      out[x] = PixelTraits<T>::clip(sums[x] / divisor);
+  }
+};
+
+/***************************************************************************//**
+ * MaskMedian
+ * Author - Dan Andrus
+ *
+ * Reducer for filterMedian: the median of the pixels under the non-zero
+ * entries of a mask, or the average of the two middle ones.
+ ******************************************************************************/
+template <class T>
+struct MaskMedian : PixelReducer< MaskMedian<T>, T >
+{
+  static const planeInput input = ColourInput;
+
+  MaskShape shape;                      // Reach of the mask
+  vector<int> cols;                     // Mask column of each non-zero entry
+  vector<int> rows;                     // Mask row of each non-zero entry
+  vector<T> values;                     // Pixels under the mask
+
+  MaskMedian(int** mask, int mask_w, int mask_h) : shape(mask_w, mask_h)
+  {
+    for (int k = 0; k < mask_h; ++k)
+      for (int l = 0; l < mask_w; ++l)
+        if (mask[k][l] != 0)
+        {
+          cols.push_back(l);
+          rows.push_back(k);
+        }
+  }
+
+  T operator()(const Neighborhood<T>& hood)
+  {
+    size_t half;                        // Rank of the median
+
+    values.clear();
+    for (size_t t = 0; t < cols.size(); ++t)
+      values.push_back(hood.at(cols[t], rows[t]));
+    if (values.empty()) return 0;
+
+    sort(values.begin(), values.end());
+
+    half = values.size() / 2;
+    if (values.size() % 2 == 0)
+      return (T) ((values[half] + values[half - 1]) / 2);
+    return values[half];
+  }
+};
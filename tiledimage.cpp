@@ -0,0 +1,356 @@
+/***************************************************************************//**
+ * tiledimage.cpp
+ *
+ * Author - Derek Stotz
+ *
+ * Date - October 18, 2026
+ *
+ * Details - Tiled image storage with tiles shared between snapshots. Snapshots
+ * cost one pointer per tile plus whatever tiles actually changed.
+ *
+ ******************************************************************************/
+
+#include "tiledimage.h"
+#include <cstring>
+#include <set>
+
+/***************************************************************************//**
+ * TiledImage::TiledImage
+ * Author - Derek Stotz
+ *
+ * Creates an empty tiled image.
+ ******************************************************************************/
+TiledImage::TiledImage() : w(0), h(0), across(0), down(0)
+{
+}
+
+/***************************************************************************//**
+ * storeTile
+ * Author - Derek Stotz
+ *
+ * Copies the part of an unpacked image covered by one tile into the tile.
+ *
+ * Parameters -
+ *          planes - the unpacked image
+ *          tile - receives the pixels
+ *          x0 - first column the tile covers
+ *          y0 - first row the tile covers
+ ******************************************************************************/
+static void storeTile(const ImagePlanes& planes, Tile& tile, int x0, int y0)
+{
+  int tw = std::min(TILE_SIZE, planes.width - x0);
+  int th = std::min(TILE_SIZE, planes.height - y0);
+
+  for (int i = 0; i < th; i++)
+  {
+    size_t p = (size_t) (y0 + i) * planes.width + x0;
+    memcpy(tile.red + i * TILE_SIZE, &planes.red[p], tw);
+    memcpy(tile.green + i * TILE_SIZE, &planes.green[p], tw);
+    memcpy(tile.blue + i * TILE_SIZE, &planes.blue[p], tw);
+  }
+}
+
+/***************************************************************************//**
+ * loadTile
+ * Author - Derek Stotz
+ *
+ * Copies a tile back into the part of an unpacked image it covers.
+ *
+ * Parameters -
+ *          tile - the pixels to copy
+ *          planes - the unpacked image to write into
+ *          x0 - first column the tile covers
+ *          y0 - first row the tile covers
+ ******************************************************************************/
+static void loadTile(const Tile& tile, ImagePlanes& planes, int x0, int y0)
+{
+  int tw = std::min(TILE_SIZE, planes.width - x0);
+  int th = std::min(TILE_SIZE, planes.height - y0);
+
+  for (int i = 0; i < th; i++)
+  {
+    size_t p = (size_t) (y0 + i) * planes.width + x0;
+    memcpy(&planes.red[p], tile.red + i * TILE_SIZE, tw);
+    memcpy(&planes.green[p], tile.green + i * TILE_SIZE, tw);
+    memcpy(&planes.blue[p], tile.blue + i * TILE_SIZE, tw);
+  }
+}
+
+/***************************************************************************//**
+ * sameTile
+ * Author - Derek Stotz
+ *
+ * Checks whether a tile holds the same pixels as the part of an unpacked
+ * image it covers.
+ *
+ * Parameters -
+ *          planes - the unpacked image
+ *          tile - the tile to compare
+ *          x0 - first column the tile covers
+ *          y0 - first row the tile covers
+ *
+ * Returns
+ *          True if every pixel matches
+ ******************************************************************************/
+static bool sameTile(const ImagePlanes& planes, const Tile& tile, int x0, int y0)
+{
+  int tw = std::min(TILE_SIZE, planes.width - x0);
+  int th = std::min(TILE_SIZE, planes.height - y0);
+
+  for (int i = 0; i < th; i++)
+  {
+    size_t p = (size_t) (y0 + i) * planes.width + x0;
+    if (memcmp(tile.red + i * TILE_SIZE, &planes.red[p], tw) ||
+        memcmp(tile.green + i * TILE_SIZE, &planes.green[p], tw) ||
+        memcmp(tile.blue + i * TILE_SIZE, &planes.blue[p], tw))
+      return false;
+  }
+
+  return true;
+}
+
+/***************************************************************************//**
+ * TiledImage::fromPlanes
+ * Author - Derek Stotz
+ *
+ * Fills the tiled image from an unpacked image. If an earlier tiled image of
+ * the same size is given, tiles that still hold the same pixels are shared
+ * with it instead of being allocated again.
+ *
+ * Parameters -
+ *          planes - the unpacked image to store
+ *          previous - an earlier version of the image, or null
+ ******************************************************************************/
+void TiledImage::fromPlanes(const ImagePlanes& planes, const TiledImage* previous)
+{
+  w = planes.width;
+  h = planes.height;
+  across = (w + TILE_SIZE - 1) / TILE_SIZE;
+  down = (h + TILE_SIZE - 1) / TILE_SIZE;
+  tiles.assign(across * down, std::shared_ptr<Tile>());
+
+  if (previous && (previous->w != w || previous->h != h))
+    previous = 0;
+
+  #pragma omp parallel for schedule(dynamic)
+  for (int k = 0; k < across * down; k++)
+  {
+    int x0 = (k % across) * TILE_SIZE;
+    int y0 = (k / across) * TILE_SIZE;
+
+    // Share the earlier tile if nothing in it changed
+    if (previous && sameTile(planes, *previous->tiles[k], x0, y0))
+    {
+      tiles[k] = previous->tiles[k];
+      continue;
+    }
+
+    tiles[k] = std::make_shared<Tile>();
+    storeTile(planes, *tiles[k], x0, y0);
+  }
+}
+
+/***************************************************************************//**
+ * TiledImage::toPlanes
+ * Author - Derek Stotz
+ *
+ * Copies the tiled image out into unpacked planes. The intensity plane is not
+ * stored and is left zeroed.
+ *
+ * Parameters -
+ *          planes - receives the image
+ ******************************************************************************/
+void TiledImage::toPlanes(ImagePlanes& planes) const
+{
+  planes.width = w;
+  planes.height = h;
+  planes.red.resize(w * h);
+  planes.green.resize(w * h);
+  planes.blue.resize(w * h);
+  planes.intensity.assign(w * h, 0);
+  planes.gray = false;
+
+  #pragma omp parallel for
+  for (int k = 0; k < across * down; k++)
+    loadTile(*tiles[k], planes, (k % across) * TILE_SIZE, (k / across) * TILE_SIZE);
+}
+
+/***************************************************************************//**
+ * TiledImage::tile
+ * Author - Derek Stotz
+ *
+ * Parameters -
+ *          tx - column of the tile
+ *          ty - row of the tile
+ *
+ * Returns
+ *          The tile, for reading only
+ ******************************************************************************/
+const Tile& TiledImage::tile(int tx, int ty) const
+{
+  return *tiles[ty * across + tx];
+}
+
+/***************************************************************************//**
+ * TiledImage::width
+ * Author - Derek Stotz
+ *
+ * Returns
+ *          The number of columns in the image
+ ******************************************************************************/
+int TiledImage::width() const
+{
+  return w;
+}
+
+/***************************************************************************//**
+ * TiledImage::height
+ * Author - Derek Stotz
+ *
+ * Returns
+ *          The number of rows in the image
+ ******************************************************************************/
+int TiledImage::height() const
+{
+  return h;
+}
+
+/***************************************************************************//**
+ * TiledImage::tilesAcross
+ * Author - Derek Stotz
+ *
+ * Returns
+ *          The number of tiles in each row of tiles
+ ******************************************************************************/
+int TiledImage::tilesAcross() const
+{
+  return across;
+}
+
+/***************************************************************************//**
+ * TiledImage::tilesDown
+ * Author - Derek Stotz
+ *
+ * Returns
+ *          The number of rows of tiles
+ ******************************************************************************/
+int TiledImage::tilesDown() const
+{
+  return down;
+}
+
+/***************************************************************************//**
+ * SnapshotHistory::checkpoint
+ * Author - Derek Stotz
+ *
+ * Saves the current state of an image on top of the history.
+ *
+ * Parameters -
+ *          image - the image to save
+ *
+ * Returns
+ *          True if the operation was successful, false if the image is null
+ ******************************************************************************/
+bool SnapshotHistory::checkpoint(Image& image)
+{
+  ImagePlanes planes;
+  TiledImage snapshot;
+
+  if (!unpackImage(image, planes)) return false;
+
+  snapshot.fromPlanes(planes, snapshots.empty() ? 0 : &snapshots.back());
+  snapshots.push_back(snapshot);
+  return true;
+}
+
+/***************************************************************************//**
+ * SnapshotHistory::undo
+ * Author - Derek Stotz
+ *
+ * Restores the most recent snapshot and removes it from the history.
+ *
+ * Parameters -
+ *          image - receives the snapshot; must be the same size
+ *
+ * Returns
+ *          True if a snapshot was restored, false if the history is empty
+ ******************************************************************************/
+bool SnapshotHistory::undo(Image& image)
+{
+  ImagePlanes planes;
+
+  if (snapshots.empty()) return false;
+  if (snapshots.back().width() != image.Width() ||
+      snapshots.back().height() != image.Height())
+    return false;
+
+  snapshots.back().toPlanes(planes);
+  packImage(planes, image);
+  snapshots.pop_back();
+  return true;
+}
+
+/***************************************************************************//**
+ * SnapshotHistory::reset
+ * Author - Derek Stotz
+ *
+ * Restores the oldest snapshot and empties the history.
+ *
+ * Parameters -
+ *          image - receives the snapshot; must be the same size
+ *
+ * Returns
+ *          True if a snapshot was restored, false if the history is empty
+ ******************************************************************************/
+bool SnapshotHistory::reset(Image& image)
+{
+  if (snapshots.empty()) return false;
+
+  snapshots.resize(1);
+  return undo(image);
+}
+
+/***************************************************************************//**
+ * SnapshotHistory::clear
+ * Author - Derek Stotz
+ *
+ * Drops every snapshot.
+ ******************************************************************************/
+void SnapshotHistory::clear()
+{
+  snapshots.clear();
+}
+
+/***************************************************************************//**
+ * SnapshotHistory::size
+ * Author - Derek Stotz
+ *
+ * Returns
+ *          The number of snapshots held
+ ******************************************************************************/
+int SnapshotHistory::size() const
+{
+  return (int) snapshots.size();
+}
+
+/***************************************************************************//**
+ * SnapshotHistory::bytesUsed
+ * Author - Derek Stotz
+ *
+ * Adds up the pixel memory held by the history, counting each shared tile
+ * only once.
+ *
+ * Returns
+ *          Bytes of tile storage in use
+ ******************************************************************************/
+size_t SnapshotHistory::bytesUsed() const
+{
+  std::set<const Tile*> seen;
+
+  for (size_t s = 0; s < snapshots.size(); s++)
+    for (int ty = 0; ty < snapshots[s].tilesDown(); ty++)
+      for (int tx = 0; tx < snapshots[s].tilesAcross(); tx++)
+        seen.insert(&snapshots[s].tile(tx, ty));
+
+  return seen.size() * sizeof(Tile);
+}
@@ -0,0 +1,86 @@
+/***************************************************************************//**
+ * tiledimage.h
+ *
+ * Author - Derek Stotz
+ *
+ * Date - October 18, 2026
+ *
+ * Details - Contains the declarations for the shared-tile image storage and
+ * the snapshot history built on it.
+ *
+ ******************************************************************************/
+
+#pragma once
+#include "planes.h"
+#include <memory>
+
+// Width and height of a tile in pixels
+static const int TILE_SIZE = 64;
+
+/***************************************************************************//**
+ * Tile
+ *
+ * Author - Derek Stotz
+ *
+ * One TILE_SIZE x TILE_SIZE block of red, green and blue values. Tiles on the
+ * right and bottom edges only use part of their storage.
+ ******************************************************************************/
+struct Tile
+{
+  uchar red[TILE_SIZE * TILE_SIZE];
+  uchar green[TILE_SIZE * TILE_SIZE];
+  uchar blue[TILE_SIZE * TILE_SIZE];
+};
+
+/***************************************************************************//**
+ * TiledImage
+ *
+ * Author - Derek Stotz
+ *
+ * An image stored as reference-counted tiles, which are never written once
+ * filled. Copying a TiledImage only copies the tile pointers, and building a
+ * TiledImage against an earlier one shares every tile whose pixels did not
+ * change.
+ ******************************************************************************/
+class TiledImage
+{
+  public:
+    TiledImage();
+    void fromPlanes(const ImagePlanes& planes, const TiledImage* previous = 0);
+    void toPlanes(ImagePlanes& planes) const;
+    const Tile& tile(int tx, int ty) const;
+    int width() const;
+    int height() const;
+    int tilesAcross() const;
+    int tilesDown() const;
+
+  private:
+    int w;                              // Columns in the image
+    int h;                              // Rows in the image
+    int across;                         // Tiles per row of tiles
+    int down;                           // Rows of tiles
+    vector< std::shared_ptr<Tile> > tiles; // Row-major tile pointers
+};
+
+/***************************************************************************//**
+ * SnapshotHistory
+ *
+ * Author - Derek Stotz
+ *
+ * A stack of image snapshots for undo and reset. Each snapshot shares its
+ * unchanged tiles with the one before it, so memory grows with how much of
+ * the image each step changed rather than with the number of steps.
+ ******************************************************************************/
+class SnapshotHistory
+{
+  public:
+    bool checkpoint(Image& image);
+    bool undo(Image& image);
+    bool reset(Image& image);
+    void clear();
+    int size() const;
+    size_t bytesUsed() const;
+
+  private:
+    vector<TiledImage> snapshots;       // Oldest first
+};
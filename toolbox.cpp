@@ -1,106 +1,48 @@
 #include "toolbox.h"
+#include "asyncfilter.h"
+#include "region.h"
+#include "sparsemask.h"
+#include "neighborhood.h"
 
 /***************************************************************************//**
  * filterAverage
  * Author - Dan Andrus
  *
- * Applies an averaging filter to an image using the supplied mask.
+ * Applies an averaging filter to an image using the supplied mask. The mask
+ * is compiled into its non-zero taps first, so a mask made mostly of zeros
+ * costs only as much as the taps it actually has.
  *
  * Parameters - 
  *          image - the image object to manipulate.
  *          mask - the 2d integer mask to apply to the image
  *          mask_w - columns in the mask
  *          mask_h - rows in the mask
+ *          regions - rectangles to filter; the active regions if not given
  *
  * Returns
  *          True if the operation was successful, false if not
  ******************************************************************************/
-bool filterAverage(Image& image, int** mask, int mask_w, int mask_h, bool gray)
+bool filterAverage(Image& image, int** mask, int mask_w, int mask_h, bool gray,
+                   const vector<Rect>* regions)
 {
   // Make sure image isn't null
   if (image.IsNull()) return false;
   
   // Initialize variables
-  Image copy;                           // Copy of original image
-  int img_w;                            // Overal image width
-  int img_h;                            // Overal image height
-  int mask_sum;                         // Sum of numbers in mask
-  int sum[3];                           // Sum of all colors
-  int center_x;                         // Center of mask
-  int center_y;                         // Center of mask
-  int i, j, k, l, x, y;                 // Temporary variables
+  vector<Rect> rects;                   // Regions to filter
+  int i, j, r;                          // Temporary variables
   
-  // Copy image due to nature of algorithm
-  copy = image;
-  
-  // Get image dimensions
-  img_w = image.Width();
-  img_h = image.Height();
-  
-  // Calculate mask total
-  mask_sum = 0;
-  for (i = 0; i < mask_h; ++i)
-    for (j = 0; j < mask_w; ++j)
-      mask_sum += mask[i][j];
-  
-  // Avoid division by 0
-  if (mask_sum < 1) mask_sum = 1;
-  
-  // Find center of mask. If mask is even x even, take top-left of center 4
-  center_x = mask_w / 2 - (1 - mask_w % 2);
-  center_y = mask_h / 2 - (1 - mask_h % 2);
+  if (!neighborhoodImage(image, MaskAverage<uchar>(compileMask(mask, mask_w, mask_h)), regions))
+    return false;
   
-  // Begin applying mask to image
-  for (i = 0; i < img_h; ++i)           // Loop over rows
+  // Convert to grayscale if gray is set
+  if (gray)
   {
-    for (j = 0; j < img_w; ++j)         // Loop over columns
-    {
-      // Reset variables
-      sum[0] = 0;
-      sum[1] = 0;
-      sum[2] = 0;
-      
-      // Center mask over pixel and take weighted average
-      for (k = 0; k < mask_h; ++k)      // Loop over mask rows
-      {
-        for (l = 0; l < mask_w; ++l)    // Loop over mask columns
-        {
-          // Temporarily store variable of current pixel to sum
-          x = j + (l - center_x);
-          y = i + (k - center_y);
-          
-          // If a pixel would be out of bounds, use nearest valid pixel
-          if (x < 0)      x = 0;
-          if (x >= img_w) x = img_w - 1;
-          if (y < 0)      y = 0;
-          if (y >= img_h) y = img_h - 1;
-          
-          // Add RGB values to sum with weights
-          sum[0] += copy[y][x].Red() * mask[k][l];
-          sum[1] += copy[y][x].Green() * mask[k][l];
-          sum[2] += copy[y][x].Blue() * mask[k][l];
-        }
-      }
-      
-      // Average out the sum, truncating decimals
-      sum[0] /= mask_sum;
-      sum[1] /= mask_sum;
-      sum[2] /= mask_sum;
-      
-      // Clip values should they be invalid
-      for (k = 0; k < 3; ++k)
-      {
-        if (sum[k] < 0)     sum[k] = 0;
-        if (sum[k] >= 256)  sum[k] = 256-1; // Why not 255? to match lines 69-72
-      }
-      
-      // Put new RGB values into image
-      image[i][j].SetRGB(sum[0], sum[1], sum[2]);
-      
-      // Convert to grayscale if gray is set
-      if (gray)
-        image[i][j].SetGray(image[i][j]);
-    }
+    rects = imageRegions(image.Width(), image.Height(), regions);
+    for (r = 0; r < (int)rects.size(); ++r)
+      for (i = rects[r].y; i < rects[r].y + rects[r].h; ++i)
+        for (j = rects[r].x; j < rects[r].x + rects[r].w; ++j)
+          image[i][j].SetGray(image[i][j]);
   }
   
   return true;
@@ -117,184 +59,72 @@ bool filterAverage(Image& image, int** mask, int mask_w, int mask_h, bool gray)
  *          mask - the 2d integer mask to apply to the image
  *          mask_w - columns in the mask
  *          mask_h - rows in the mask
+ *          regions - rectangles to filter; the active regions if not given
  *
  * Returns
  *          True if the operation was successful, false if not
  ******************************************************************************/
-bool filterMedian(Image& image, int** mask, int mask_w, int mask_h)
+bool filterMedian(Image& image, int** mask, int mask_w, int mask_h,
+                  const vector<Rect>* regions)
 {
-  // Make sure image isn't null
-  if (image.IsNull()) return false;
-  
-  // Initialize variables
-  Image copy;                           // Copy of original image
-  int img_w;                            // Overal image width
-  int img_h;                            // Overal image height
-  int median[3];                        // Median of all colors
-  int center_x;                         // Center of mask
-  int center_y;                         // Center of mask
-  int i, j, k, l, x, y;                 // Temporary variables
-  
-  vector<int> red_list;                 // Intensity values for red
-  vector<int> gre_list;                 // Intensity values for green
-  vector<int> blu_list;                 // Intensity values for blu
-  
-  // Copy image due to nature of algorithm
-  copy = image;
-  
-  // Get image dimensions
-  img_w = image.Width();
-  img_h = image.Height();
-  
-  // Find center of mask. If mask is even x even, take top-left of center 4
-  center_x = mask_w / 2 - (1 - mask_w % 2);
-  center_y = mask_h / 2 - (1 - mask_h % 2);
-  
-  // Begin applying mask to image
-  for (i = 0; i < img_h; ++i)           // Loop over rows
+  return neighborhoodImage(image, MaskMedian<uchar>(mask, mask_w, mask_h), regions);
+}
+
+/***************************************************************************//**
+ * MaskEmboss
+ * Author - Dan Andrus
+ *
+ * Reducer for filterEmboss: the weighted sum of the intensities under the
+ * non-zero taps of a mask, halved and moved up to mid-gray.
+ ******************************************************************************/
+struct MaskEmboss
+{
+  static const planeInput input = IntensityInput;
+
+  MaskShape shape;                      // Reach of the non-zero taps
+  SparseMask mask;                      // The compiled mask
+  vector<PixelTraits<uchar>::lane> acc;  // Scratch space for sparseRow
+  vector<int> sums;                     // Weighted sums of a row
+
+  MaskEmboss(const SparseMask& m) : shape(m.left, m.right, m.top, m.bottom), mask(m) {}
+
+  void reduceRow(const uchar* const* rows, int n, uchar* out)
   {
-    for (j = 0; j < img_w; ++j)         // Loop over columns
+    int sum;                            // Embossed value of one pixel
+
+    sparseRow(mask, rows, n, acc, sums);
+    for (int x = 0; x < n; x++)
     {
-      // Reset variables
-      red_list.clear();
-      gre_list.clear();
-      blu_list.clear();
-      median[0] = 0;
-      median[1] = 0;
-      median[2] = 0;
-      
-      // Center mask over pixel and take weighted average
-      for (k = 0; k < mask_h; ++k)      // Loop over mask rows
-      {
-        for (l = 0; l < mask_w; ++l)    // Loop over mask columns
-        {
-          // Skip if value in mask is 0
-          if (mask[k][l] == 0) continue;
-          
-          // Temporarily store location of pixel in mask
-          x = j + (l - center_x);
-          y = i + (k - center_y);
-          
-          // If a pixel would be out of bounds, use nearest valid pixel
-          if (x < 0)      x = 0;
-          if (x >= img_w) x = img_w - 1;
-          if (y < 0)      y = 0;
-          if (y >= img_h) y = img_h - 1;
-          
-          // Add RGB values to lists
-          red_list.push_back(copy[y][x].Red());
-          gre_list.push_back(copy[y][x].Green());
-          blu_list.push_back(copy[y][x].Blue());
-        }
-      }
-      
-      // Sort lists
-      sort(red_list.begin(), red_list.end());
-      sort(gre_list.begin(), gre_list.end());
-      sort(blu_list.begin(), blu_list.end());
-      
-      // Calculate medians
-      median[0] = red_list[red_list.size() / 2];
-      if (red_list.size() % 2 == 0 && red_list.size() > 0)
-        median[0] = (median[0] + red_list[(red_list.size() / 2) - 1]) / 2;
-      
-      median[1] = gre_list[gre_list.size() / 2];
-      if (gre_list.size() % 2 == 0 && gre_list.size() > 0)
-        median[1] = (median[1] + gre_list[(gre_list.size() / 2) - 1]) / 2;
-      
-      median[2] = blu_list[blu_list.size() / 2];
-      if (blu_list.size() % 2 == 0 && blu_list.size() > 0)
-        median[2] = (median[2] + blu_list[(blu_list.size() / 2) - 1]) / 2;
-      
-      // Put new RGB values into image
-      image[i][j].SetRGB(median[0], median[1], median[2]);
+      // Add 127 and scale for embossing, and clip
+      sum = 127 + (sums[x] / 2);
+      if (sum < 0)     sum = 0;
+      if (sum >= 256)  sum = 256-1;
+      out[x] = sum;
     }
   }
-  
-  return true;
-}
+};
 
 /***************************************************************************//**
  * filterEmboss
  * Author - Dan Andrus
  *
- * Embosses the given image object.
+ * Embosses the given image object. Like filterAverage, only the non-zero taps
+ * of the mask are visited.
  *
  * Parameters - 
  *          image - the image object to manipulate.
  *          mask - the 2d integer mask to apply to the image
  *          mask_w - columns in the mask
  *          mask_h - rows in the mask
+ *          regions - rectangles to filter; the active regions if not given
  *
  * Returns
  *          True if the operation was successful, false if not
  ******************************************************************************/
-bool filterEmboss(Image& image, int** mask, int mask_w, int mask_h)
+bool filterEmboss(Image& image, int** mask, int mask_w, int mask_h,
+                  const vector<Rect>* regions)
 {
-  // Make sure image isn't null
-  if (image.IsNull()) return false;
-  
-  // Initialize variables
-  Image copy;                           // Copy of original image
-  int img_w;                            // Overal image width
-  int img_h;                            // Overal image height
-  int sum;                              // Sum of intensities
-  int center_x;                         // Center of mask
-  int center_y;                         // Center of mask
-  int i, j, k, l, x, y;                 // Temporary variables
-  
-  // Copy image due to nature of algorithm
-  copy = image;
-  
-  // Get image dimensions
-  img_w = image.Width();
-  img_h = image.Height();
-  
-  // Find center of mask. If mask is even x even, take top-left of center 4
-  center_x = mask_w / 2 - (1 - mask_w % 2);
-  center_y = mask_h / 2 - (1 - mask_h % 2);
-  
-  // Begin applying mask to image
-  for (i = 0; i < img_h; ++i)           // Loop over rows
-  {
-    for (j = 0; j < img_w; ++j)         // Loop over columns
-    {
-      // Reset variables
-      sum = 0;
-      
-      // Center mask over pixel and take weighted average
-      for (k = 0; k < mask_h; ++k)      // Loop over mask rows
-      {
-        for (l = 0; l < mask_w; ++l)    // Loop over mask columns
-        {
-          // Temporarily store variable of current pixel to sum
-          x = j + (l - center_x);
-          y = i + (k - center_y);
-          
-          // If a pixel would be out of bounds, use nearest valid pixel
-          if (x < 0)      x = 0;
-          if (x >= img_w) x = img_w - 1;
-          if (y < 0)      y = 0;
-          if (y >= img_h) y = img_h - 1;
-          
-          // Add intensity values to sum with weights
-          sum += copy[y][x] * mask[k][l];
-        }
-      }
-      
-      // Add 127 and scale for embossing
-      sum = 127 + (sum / 2);
-           
-      // Clip values should they be invalid
-      if (sum < 0)     sum = 0;
-      if (sum >= 256)  sum = 256-1; // Why not 255? to match lines 69-72
-      
-      // Put new RGB values into image
-      image[i][j].SetGray(sum);
-    }
-  }
-  
-  return true;
+  return neighborhoodImage(image, MaskEmboss(compileMask(mask, mask_w, mask_h)), regions);
 }
 
 /***************************************************************************//**
@@ -346,33 +176,28 @@ void dealloc2d(int** array, int h)
  * one of several different filters to the pixel using the ranked order of the pixel
  * values.  This makes use of the operation enum found in DerekProcessor.h.
  *
+ * The filter itself runs in the background (see statisticBand) behind a
+ * progress dialog that can cancel it, leaving the image as it was.
+ *
  * Parameters -
  *          image - the image to filter
  *          mask_w - the mask width (and height)
  *          op - the operation (Min, Max, Median, or Mean)
+ *          regions - rectangles to filter; the active regions if not given
  ******************************************************************************/
-bool filterStatistic(Image& image, operation op)
+bool filterStatistic(Image& image, operation op, const vector<Rect>* regions)
 {
   // Make sure image isn't null
   if (image.IsNull()) return false;
 
   // Initialize variables
-  Image copy;                           // Copy of original image
-  int img_w;                            // Overal image width
-  int img_h;                            // Overal image height
   int mask_w = 3;                       // The width of the filter
-  int val[3];                           // New values of all colors
-  int center;                           // Center of mask (x and y are the same in any case)
-  int i, j, k, l, x, y, m;             // Temporary variables
   int threshold = 0;                        // Threshold for noise removal
-  int sum[3] = {0};
-
-  vector<int> red_list;                 // Intensity values for red
-  vector<int> gre_list;                 // Intensity values for green
-  vector<int> blu_list;                 // Intensity values for blu
+  FilterTask task;                      // What to run in the background
 
-  // Copy image due to nature of algorithm
-  copy = image;
+  // Only the colour operations are handled here
+  if (op != Min && op != Max && op != Mean && op != Median && op != NoiseClean)
+    return false;
 
   // Ask the user for the dimensions of the filer
   if (!Dialog("Dialog").Add(mask_w, "Filter Width").Show() || mask_w < 2)
@@ -382,151 +207,115 @@ bool filterStatistic(Image& image, operation op)
   if (op == NoiseClean && !Dialog("Noise Removal").Add(threshold, "Threshold", 0, 255).Show())
     return false;
 
-  // Get image dimensions
-  img_w = image.Width();
-  img_h = image.Height();
+  task.kind = StatisticFilter;
+  task.op = op;
+  task.mask_w = mask_w;
+  task.threshold = threshold;
+  task.mag = false;
 
-  // Find center of mask. If mask is even x even, take top-left of center 4
-  center = mask_w / 2 - (1 - mask_w % 2);
+  return runWithProgress(image, task, "Rank Order Filter", regions);
+}
 
-  // Begin applying filter to image
-  for (i = 0; i < img_h; ++i)           // Loop over rows
-  {
-    for (j = 0; j < img_w; ++j)         // Loop over columns
-    {
-      // Reset variables
-      red_list.clear();
-      gre_list.clear();
-      blu_list.clear();
-      val[0] = 0;
-      val[1] = 0;
-      val[2] = 0;
-
-      // Center mask over pixel and take weighted average
-      for (k = 0; k < mask_w; ++k)      // Loop over mask rows
-      {
-        for (l = 0; l < mask_w; ++l)    // Loop over mask columns
-        {
-          // Temporarily store location of pixel in mask
-          x = j + (l - center);
-          y = i + (k - center);
-
-          // If a pixel would be out of bounds, use nearest valid pixel
-          if (x < 0)      x = 0;
-          if (x >= img_w) x = img_w - 1;
-          if (y < 0)      y = 0;
-          if (y >= img_h) y = img_h - 1;
-
-          // Add RGB values to lists
-          red_list.push_back(copy[y][x].Red());
-          gre_list.push_back(copy[y][x].Green());
-          blu_list.push_back(copy[y][x].Blue());
-        }
-      }
+/***************************************************************************//**
+ * StatisticReducer
+ * Author - Dan Andrus & Derek Stotz
+ *
+ * Reducer for the filterStatistic operations over a square mask.
+ ******************************************************************************/
+struct StatisticReducer : PixelReducer<StatisticReducer>
+{
+  static const planeInput input = ColourInput;
 
-      if (op != Mean && op != NoiseClean)
-      {
-          // Sort lists if they aren't going to be averaged
-          sort(red_list.begin(), red_list.end());
-          sort(gre_list.begin(), gre_list.end());
-          sort(blu_list.begin(), blu_list.end());
-      }
+  MaskShape shape;                      // Reach of the mask
+  operation op;                         // The operation to apply
+  int mask_w;                           // The mask width (and height)
+  int threshold;                        // Threshold for NoiseClean
+  vector<int> values;                   // Pixels under the mask
 
-      // Calculate the new value, depending on the operation
+  StatisticReducer(operation o, int w, int t)
+    : shape(w, w), op(o), mask_w(w), threshold(t) {}
 
-      switch(op)
-      {
-      case Min:
-          // set the new RGB values to the min values
-          val[0] = red_list[0];
-          val[1] = gre_list[0];
-          val[2] = blu_list[0];
-          break;
-
-      case Max:  // set the new RGB values to the max values
-          val[0] = red_list[red_list.size()-1];
-          val[1] = gre_list[gre_list.size()-1];
-          val[2] = blu_list[blu_list.size()-1];
-          break;
-
-      case NoiseClean:
-          sum[0] = 0;
-          sum[1] = 0;
-          sum[2] = 0; // the sum of the three colors
-
-          for( m = 0; m < (int)red_list.size(); m++)
-          {
-              sum[0] += red_list[m];
-              sum[1] += gre_list[m];
-              sum[2] += blu_list[m];
-          }
-
-          sum[0] /= red_list.size();
-          sum[1] /= gre_list.size();
-          sum[2] /= blu_list.size();
-
-          // replace the pixel with the average if the value - the averages
-          //    exceed the user-specified threshold.
-
-          if (abs(sum[0] - copy[i][j].Red()) > threshold)
-            val[0] = sum[0];
-          else
-            val[0] = copy[i][j].Red();
-
-          if (abs(sum[1] - copy[i][j].Green()) > threshold)
-            val[1] = sum[1];
-          else
-            val[1] = copy[i][j].Green();
-
-          if (abs(sum[2] - copy[i][j].Blue()) > threshold)
-            val[2] = sum[2];
-          else
-            val[2] = copy[i][j].Blue();
-
-          break;
-
-      case Median:  // find the medians, or the average of the two medians
-          val[0] = red_list[red_list.size() / 2];
-          if (red_list.size() % 2 == 0 && red_list.size() > 0)
-            val[0] = (val[0] + red_list[(red_list.size() / 2) - 1]) / 2;
-
-          val[1] = gre_list[gre_list.size() / 2];
-          if (gre_list.size() % 2 == 0 && gre_list.size() > 0)
-            val[1] = (val[1] + gre_list[(gre_list.size() / 2) - 1]) / 2;
-
-          val[2] = blu_list[blu_list.size() / 2];
-          if (blu_list.size() % 2 == 0 && blu_list.size() > 0)
-            val[2] = (val[2] + blu_list[(blu_list.size() / 2) - 1]) / 2;
-          break;
-
-      case Mean:
-          sum[0] = 0;
-          sum[1] = 0;
-          sum[2] = 0; // the sum of the three colors
-
-          for( m = 0; m < (int)red_list.size(); m++)
-          {
-              sum[0] += red_list[m];
-              sum[1] += gre_list[m];
-              sum[2] += blu_list[m];
-          }
-
-          val[0] = sum[0] / red_list.size();
-          val[1] = sum[1] / gre_list.size();
-          val[2] = sum[2] / blu_list.size();
-          break;
-
-      default:  // if it's any other operation, it should probably be a grayscale one.
-
-          return false;
-      }
+  uchar operator()(const Neighborhood<uchar>& hood)
+  {
+    int center = hood.at(shape.left, shape.top);
+    int val = 0;                        // New value of the pixel
+    int sum;
+    int k, l, m;                        // Temporary variables
+
+    values.clear();
+    for (k = 0; k < mask_w; ++k)        // Loop over mask rows
+      for (l = 0; l < mask_w; ++l)      // Loop over mask columns
+        values.push_back(hood.at(l, k));
 
-      // Put new RGB values into image
-      image[i][j].SetRGB(val[0], val[1], val[2]);
+    // Sort lists if they aren't going to be averaged
+    if (op != Mean && op != NoiseClean)
+      sort(values.begin(), values.end());
+
+    switch(op)
+    {
+    case Min:  // set the new value to the min value
+        val = values[0];
+        break;
+
+    case Max:  // set the new value to the max value
+        val = values[values.size()-1];
+        break;
+
+    case NoiseClean:
+        sum = 0;
+        for( m = 0; m < (int)values.size(); m++)
+            sum += values[m];
+        sum /= values.size();
+
+        // replace the pixel with the average if the value - the average
+        //    exceeds the user-specified threshold.
+        if (abs(sum - center) > threshold)
+          val = sum;
+        else
+          val = center;
+        break;
+
+    case Median:  // find the median, or the average of the two medians
+        val = values[values.size() / 2];
+        if (values.size() % 2 == 0 && values.size() > 0)
+          val = (val + values[(values.size() / 2) - 1]) / 2;
+        break;
+
+    case Mean:
+        sum = 0;
+        for( m = 0; m < (int)values.size(); m++)
+            sum += values[m];
+        val = sum / values.size();
+        break;
+
+    default:  // if it's any other operation, it should probably be a grayscale one.
+        break;
     }
+
+    return val;
   }
+};
 
-  return true;
+/***************************************************************************//**
+ *statisticBand
+ * Author - Dan Andrus & Derek Stotz
+ *
+ * Applies one of the filterStatistic operations to a band of rows of an
+ * unpacked image, or any other rectangle of it. Reads only from src, so bands
+ * can be filtered in parallel. Grey images are filtered as a single channel.
+ *
+ * Parameters -
+ *          src - the unpacked image to filter
+ *          dst - receives the filtered rows; same size as src
+ *          area - the rectangle of src to filter
+ *          op - the operation (Min, Max, Median, Mean or NoiseClean)
+ *          mask_w - the mask width (and height)
+ *          threshold - how far from the mean a pixel must be to be cleaned
+ ******************************************************************************/
+void statisticBand(const ImagePlanes& src, ImagePlanes& dst, const Rect& area,
+                   operation op, int mask_w, int threshold)
+{
+  neighborhoodBand(src, dst, area, StatisticReducer(op, mask_w, threshold));
 }
 
 
@@ -538,106 +327,219 @@ bool filterStatistic(Image& image, operation op)
  * one of several different filters to the pixel using the ranked order of the pixel
  * values.  This makes use of the operation enum found in DerekProcessor.h.
  *
+ * Like filterStatistic, the filter runs in the background behind a progress
+ * dialog.
+ *
  * Parameters -
  *          image - the image to filter
  *          op - the operation (either standard deviation or range)
+ *          regions - rectangles to filter; the active regions if not given
  ******************************************************************************/
-bool filterStatisticGreyscale(Image& image, operation op)
+bool filterStatisticGreyscale(Image& image, operation op, const vector<Rect>* regions)
 {
   // Make sure image isn't null
   if (image.IsNull()) return false;
 
   // Initialize variables
-  Image copy;                           // Copy of original image
   int mask_w = 3;                       // The width of the filter
-  int img_w;                            // Overal image width
-  int img_h;                            // Overal image height
-  int val;                              // New values of all colors
-  int center;                           // Center of mask (x and y are the same in any case)
-  int i, j, k, l, x, y, m, temp, avg;   // Temporary variables
+  FilterTask task;                      // What to run in the background
 
-  vector<int> list;                     // Intensity values
+  // Only the greyscale operations are handled here
+  if (op != StandardDeviation && op != Range)
+    return false;
 
   // Ask the user for the dimensions of the filer
-  if (!Dialog("Dialog").Add(mask_w, "Filter Width").Show() || mask_w == 1)
+  if (!Dialog("Dialog").Add(mask_w, "Filter Width").Show() || mask_w < 2)
       return false;
 
-  // Copy image due to nature of algorithm
-  copy = image;
+  task.kind = StatisticGreyscaleFilter;
+  task.op = op;
+  task.mask_w = mask_w;
+  task.threshold = 0;
+  task.mag = false;
 
-  // Get image dimensions
-  img_w = image.Width();
-  img_h = image.Height();
+  return runWithProgress(image, task, "Greyscale Filter", regions);
+}
 
-  // Find center of mask. If mask is even x even, take top-left of center 4
-  center = mask_w / 2 - (1 - mask_w % 2);
+/***************************************************************************//**
+ * GreyStatisticReducer
+ * Author - Dan Andrus & Derek Stotz
+ *
+ * Reducer for the filterStatisticGreyscale operations over a square mask.
+ ******************************************************************************/
+struct GreyStatisticReducer : PixelReducer<GreyStatisticReducer>
+{
+  static const planeInput input = IntensityInput;
+
+  MaskShape shape;                      // Reach of the mask
+  operation op;                         // The operation to apply
+  int mask_w;                           // The mask width (and height)
+  vector<int> list;                     // Intensity values
+
+  GreyStatisticReducer(operation o, int w) : shape(w, w), op(o), mask_w(w) {}
 
-  // Begin applying filter to image
-  for (i = 0; i < img_h; ++i)           // Loop over rows
+  uchar operator()(const Neighborhood<uchar>& hood)
   {
-    for (j = 0; j < img_w; ++j)         // Loop over columns
+    int val = 0;                        // New value of the pixel
+    int k, l, m, temp, avg;             // Temporary variables
+
+    list.clear();
+    for (k = 0; k < mask_w; ++k)        // Loop over mask rows
+      for (l = 0; l < mask_w; ++l)      // Loop over mask columns
+        list.push_back(hood.at(l, k));
+
+    // Sort lists
+    sort(list.begin(), list.end());
+
+    // Calculate the new value, depending on the operation
+
+    switch(op)
     {
-      // Reset variables
-      list.clear();
-      val = 0;
+    case StandardDeviation: // set the intensity to the stdev of surrounding pixels
+
+        // start by finding the mean
+        avg = 0;
+        for( m = 0; m < (int)list.size(); m++)
+            avg += list[m];
+        avg = avg / list.size();
+
+        // then find each square deviation and add them together
+        temp = 0;
+        for ( m = 0; m < (int)list.size(); m++)
+             temp += pow(list[m] - avg, 2);
+
+        // use the sum of the squared deviations to find the stdev
+        temp /= list.size()-1; // we know that list.size() is > 1
+        val = min((int)sqrt((double)temp), 255);
+        break;
+
+    case Range:  // set the intensity to the range of surrounding pixel values
+        val = list[list.size()-1] - list[0];
+        break;
+
+    default:  // if it's any other operation, it should probably be a non-grayscale one.
+        break;
+    }
 
-      // Center mask over pixel and take weighted average
-      for (k = 0; k < mask_w; ++k)      // Loop over mask rows
-      {
-        for (l = 0; l < mask_w; ++l)    // Loop over mask columns
-        {
-          // Temporarily store location of pixel in mask
-          x = j + (l - center);
-          y = i + (k - center);
-
-          // If a pixel would be out of bounds, use nearest valid pixel
-          if (x < 0)      x = 0;
-          if (x >= img_w) x = img_w - 1;
-          if (y < 0)      y = 0;
-          if (y >= img_h) y = img_h - 1;
-
-          // Add RGB values to lists
-          list.push_back(copy[y][x].Intensity());
-        }
-      }
+    return val;
+  }
+};
+
+/***************************************************************************//**
+ *statisticGreyscaleBand
+ * Author - Dan Andrus & Derek Stotz
+ *
+ * Applies one of the filterStatisticGreyscale operations to a band of rows of
+ * an unpacked image, writing gray pixels. Reads only from src.
+ *
+ * Parameters -
+ *          src - the unpacked image to filter
+ *          dst - receives the filtered rows; same size as src
+ *          area - the rectangle of src to filter
+ *          op - the operation (either standard deviation or range)
+ *          mask_w - the mask width (and height)
+ ******************************************************************************/
+void statisticGreyscaleBand(const ImagePlanes& src, ImagePlanes& dst,
+                            const Rect& area, operation op, int mask_w)
+{
+  neighborhoodBand(src, dst, area, GreyStatisticReducer(op, mask_w));
+}
+
+// The eight Kirsch compass masks, starting east and turning counterclockwise
+static const int kirsch_mask[8][3][3] = {{
+  {-3, -3,  5},
+  {-3,  0,  5},
+  {-3, -3,  5}
+}, {
+  {-3,  5,  5},
+  {-3,  0,  5},
+  {-3, -3, -3}
+}, {
+  { 5,  5,  5},
+  {-3,  0, -3},
+  {-3, -3, -3}
+}, {
+  { 5,  5, -3},
+  { 5,  0, -3},
+  {-3, -3, -3}
+}, {
+  { 5, -3, -3},
+  { 5,  0, -3},
+  { 5, -3, -3}
+}, {
+  {-3, -3, -3},
+  { 5,  0, -3},
+  { 5,  5, -3}
+}, {
+  {-3, -3, -3},
+  {-3,  0, -3},
+  { 5,  5,  5}
+}, {
+  {-3, -3, -3},
+  {-3,  0,  5},
+  {-3,  5,  5}
+}};
+
+/***************************************************************************//**
+ * KirschReducer
+ * Author - Dan Andrus
+ *
+ * Reducer for the Kirsch edge operator: the strongest of the eight compass
+ * responses, or its direction.
+ ******************************************************************************/
+struct KirschReducer : PixelReducer<KirschReducer>
+{
+  static const planeInput input = IntensityInput;
 
-      // Sort lists
-      sort(list.begin(), list.end());
+  MaskShape shape;                      // Reach of the masks
+  bool mag;                             // Magnitude or direction
 
-      // Calculate the new value, depending on the operation
+  KirschReducer(bool m) : shape(3, 3), mag(m) {}
 
-      switch(op)
+  uchar operator()(const Neighborhood<uchar>& hood)
+  {
+    int dir = -1;                       // Direction of max response
+    int sum[8] = { 0 };                 // Sum of responsivenesses
+    int max = -1;                       // Magnitude of max response
+    int k, l, m;                        // Temporary variables
+
+    // Center each mask over pixel and take weighted average
+    for (k = 0; k < 3; ++k)             // Loop over mask rows
+      for (l = 0; l < 3; ++l)           // Loop over mask columns
+        for (m = 0; m < 8; ++m)         // Loop over all masks
+          sum[m] += hood.at(l, k) * kirsch_mask[m][k][l];
+
+    // Find mask with max response
+    for (m = 0; m < 8; ++m)
+    {
+      if (sum[m] > max)
       {
-      case StandardDeviation: // set the intensity to the stdev of surrounding pixels
-
-          // start by finding the mean
-          avg = 0;
-          for( m = 0; m < (int)list.size(); m++)
-              avg += list[m];
-          avg = avg / list.size();
-
-          // then find each square deviation and add them together
-          temp = 0;
-          for ( m = 0; m < (int)list.size(); m++)
-               temp += pow(list[m] - avg, 2);
-
-          // use the sum of the squared deviations to find the stdev
-          temp /= list.size()-1; // we know that list.size() is > 1
-          val = min((int)sqrt((double)temp), 255);
-          break;
-
-      case Range:  // set the intensity to the range of surrounding pixel values
-          val = list[list.size()-1] - list[0];
-          break;
-
-      default:  // if it's any other operation, it should probably be a non-grayscale one.
-          return false;
+        max = sum[m];
+        dir = m;
       }
-
-      // Put new RGB values into image
-      image[i][j].SetGray(val);
     }
+
+    if (mag)
+      return std::max(0, min(255, max));
+    return dir * (256/8);
   }
+};
 
-  return true;
+/***************************************************************************//**
+ * kirschBand
+ * Author - Dan Andrus
+ *
+ * Applies the Kirsch edge operator to a band of rows of an unpacked image,
+ * writing either the strongest response or its compass direction as gray.
+ * Reads only from src, so bands can be filtered in parallel.
+ *
+ * Parameters -
+ *          src - the unpacked image to filter
+ *          dst - receives the filtered rows; same size as src
+ *          area - the rectangle of src to filter
+ *          mag - if true, highlights edges. If false, illustrates edge angles
+ ******************************************************************************/
+void kirschBand(const ImagePlanes& src, ImagePlanes& dst, const Rect& area, bool mag)
+{
+  neighborhoodBand(src, dst, area, KirschReducer(mag));
 }
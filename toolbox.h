@@ -11,10 +11,21 @@ using namespace std;
 
 enum operation{ Min, Max, Mean, Median, Range, StandardDeviation, NoiseClean };
 
-bool filterAverage(Image& image, int** mask, int mask_w, int mask_h, bool gray = false);
-bool filterMedian(Image& image, int** mask, int mask_w, int mask_h);
-bool filterEmboss(Image& image, int** mask, int mask_w, int mask_h);
+struct ImagePlanes;
+struct Rect;
+
+bool filterAverage(Image& image, int** mask, int mask_w, int mask_h, bool gray = false,
+                   const vector<Rect>* regions = 0);
+bool filterMedian(Image& image, int** mask, int mask_w, int mask_h,
+                  const vector<Rect>* regions = 0);
+bool filterEmboss(Image& image, int** mask, int mask_w, int mask_h,
+                  const vector<Rect>* regions = 0);
 int** alloc2d(int w, int h);
 void  dealloc2d(int** array, int h);
-bool filterStatisticGreyscale(Image& image, operation op);
-bool filterStatistic(Image& image, operation op);
+bool filterStatisticGreyscale(Image& image, operation op, const vector<Rect>* regions = 0);
+bool filterStatistic(Image& image, operation op, const vector<Rect>* regions = 0);
+void statisticBand(const ImagePlanes& src, ImagePlanes& dst, const Rect& area,
+                   operation op, int mask_w, int threshold);
+void statisticGreyscaleBand(const ImagePlanes& src, ImagePlanes& dst,
+                            const Rect& area, operation op, int mask_w);
+void kirschBand(const ImagePlanes& src, ImagePlanes& dst, const Rect& area, bool mag);